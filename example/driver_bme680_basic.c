@@ -63,6 +63,9 @@ uint8_t bme680_basic_init(bme680_interface_t interface, bme680_address_t addr_pi
     DRIVER_BME680_LINK_SPI_WRITE(&gs_handle, bme680_interface_spi_write);
     DRIVER_BME680_LINK_DELAY_MS(&gs_handle, bme680_interface_delay_ms);
     DRIVER_BME680_LINK_DEBUG_PRINT(&gs_handle, bme680_interface_debug_print);
+    DRIVER_BME680_LINK_BUS_LOCK(&gs_handle, bme680_interface_bus_lock);
+    DRIVER_BME680_LINK_BUS_UNLOCK(&gs_handle, bme680_interface_bus_unlock);
+    DRIVER_BME680_LINK_GET_TIME_MS(&gs_handle, bme680_interface_get_time_ms);
     
     /* set interface */
     res = bme680_set_interface(&gs_handle, interface);
@@ -186,17 +189,17 @@ uint8_t bme680_basic_init(bme680_interface_t interface, bme680_address_t addr_pi
  */
 uint8_t bme680_basic_read(float *temperature, float *pressure, float *humidity_percentage)
 {
-    uint32_t temperature_yaw;
-    uint32_t pressure_yaw;
-    uint32_t humidity_raw;
+    bme680_sample_t sample;
     
     /* read temperature pressure and humidity */
-    if (bme680_read_temperature_pressure_humidity(&gs_handle, (uint32_t *)&temperature_yaw, 
-                                                  temperature, (uint32_t *)&pressure_yaw, pressure,
-                                                 (uint32_t *)&humidity_raw, humidity_percentage) != 0)
+    if (bme680_read_sample(&gs_handle, BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY,
+                           &sample) != 0)
     {
         return 1;
     }
+    *temperature = sample.temperature_c;
+    *pressure = sample.pressure_pa;
+    *humidity_percentage = sample.humidity_percentage;
     
     return 0;
 }
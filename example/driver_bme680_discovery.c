@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_discovery.c
+ * @brief     driver bme680 discovery source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bme680_discovery.h"
+
+/**
+ * @brief      discovery example find and init the sensors of a candidate list
+ * @param[in]  *candidate pointer to a candidate list
+ * @param[in]  count candidate number
+ * @param[out] *handle pointer to a handle buffer with one handle per candidate
+ * @param[out] *found pointer to a found sensor number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sensor is found
+ *             - 2 candidate number is invalid
+ * @note       every candidate is probed by its chip id and reset before any reset time is waited,
+ *             so the 5ms reset delays overlap and the bring-up time stays flat as sensors are added,
+ *             the found sensors are packed at the front of the handle buffer and are inited
+ */
+uint8_t bme680_discovery_run(const bme680_discovery_candidate_t *candidate, uint8_t count,
+                             bme680_handle_t *handle, uint8_t *found)
+{
+    uint8_t i;
+    uint8_t started;
+    bme680_handle_t *h;
+    
+    /* check the count */
+    *found = 0;
+    if ((count == 0) || (count > BME680_DISCOVERY_MAX_CANDIDATES))
+    {
+        return 2;
+    }
+    
+    /* probe and reset every candidate */
+    started = 0;
+    for (i = 0; i < count; i++)
+    {
+        h = &handle[started];
+        
+        /* link interface function */
+        DRIVER_BME680_LINK_INIT(h, bme680_handle_t); 
+        DRIVER_BME680_LINK_IIC_INIT(h, bme680_interface_iic_init);
+        DRIVER_BME680_LINK_IIC_DEINIT(h, bme680_interface_iic_deinit);
+        DRIVER_BME680_LINK_IIC_READ(h, bme680_interface_iic_read);
+        DRIVER_BME680_LINK_IIC_WRITE(h, bme680_interface_iic_write);
+        DRIVER_BME680_LINK_SPI_INIT(h, bme680_interface_spi_init);
+        DRIVER_BME680_LINK_SPI_DEINIT(h, bme680_interface_spi_deinit);
+        DRIVER_BME680_LINK_SPI_READ(h, bme680_interface_spi_read);
+        DRIVER_BME680_LINK_SPI_WRITE(h, bme680_interface_spi_write);
+        DRIVER_BME680_LINK_DELAY_MS(h, bme680_interface_delay_ms);
+        DRIVER_BME680_LINK_DEBUG_PRINT(h, bme680_interface_debug_print);
+        DRIVER_BME680_LINK_BUS_LOCK(h, bme680_interface_bus_lock);
+        DRIVER_BME680_LINK_BUS_UNLOCK(h, bme680_interface_bus_unlock);
+        DRIVER_BME680_LINK_GET_TIME_MS(h, bme680_interface_get_time_ms);
+        
+        /* set the candidate */
+        if (bme680_set_interface(h, candidate[i].interface) != 0)
+        {
+            continue;
+        }
+        if (bme680_set_addr_pin(h, candidate[i].addr_pin) != 0)
+        {
+            continue;
+        }
+        
+        /* check the id and reset */
+        if (bme680_init_start(h) != 0)
+        {
+            continue;
+        }
+        started++;
+    }
+    
+    /* wait the shared reset time once and read the calibration */
+    for (i = 0; i < started; i++)
+    {
+        if (bme680_init_finish(&handle[i]) != 0)
+        {
+            continue;
+        }
+        if (*found != i)
+        {
+            handle[*found] = handle[i];
+        }
+        (*found)++;
+    }
+    if (*found == 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     discovery example deinit the found sensors
+ * @param[in] *handle pointer to a handle buffer
+ * @param[in] found found sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t bme680_discovery_deinit(bme680_handle_t *handle, uint8_t found)
+{
+    uint8_t i;
+    uint8_t res;
+    
+    res = 0;
+    for (i = 0; i < found; i++)
+    {
+        if (bme680_deinit(&handle[i]) != 0)
+        {
+            res = 1;
+        }
+    }
+    
+    return res;
+}
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_discovery.h
+ * @brief     driver bme680 discovery header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BME680_DISCOVERY_H
+#define DRIVER_BME680_DISCOVERY_H
+
+#include "driver_bme680_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup bme680_example_driver
+ * @{
+ */
+
+/**
+ * @brief bme680 discovery max candidates definition
+ */
+#define BME680_DISCOVERY_MAX_CANDIDATES        8        /**< 8 candidates */
+
+/**
+ * @brief bme680 discovery candidate structure definition
+ */
+typedef struct bme680_discovery_candidate_s
+{
+    bme680_interface_t interface;        /**< chip interface */
+    bme680_address_t addr_pin;           /**< iic address pin, ignored by the spi interface */
+} bme680_discovery_candidate_t;
+
+/**
+ * @brief      discovery example find and init the sensors of a candidate list
+ * @param[in]  *candidate pointer to a candidate list
+ * @param[in]  count candidate number
+ * @param[out] *handle pointer to a handle buffer with one handle per candidate
+ * @param[out] *found pointer to a found sensor number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sensor is found
+ *             - 2 candidate number is invalid
+ * @note       every candidate is probed by its chip id and reset before any reset time is waited,
+ *             so the 5ms reset delays overlap and the bring-up time stays flat as sensors are added,
+ *             the found sensors are packed at the front of the handle buffer and are inited
+ */
+uint8_t bme680_discovery_run(const bme680_discovery_candidate_t *candidate, uint8_t count,
+                             bme680_handle_t *handle, uint8_t *found);
+
+/**
+ * @brief     discovery example deinit the found sensors
+ * @param[in] *handle pointer to a handle buffer
+ * @param[in] found found sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t bme680_discovery_deinit(bme680_handle_t *handle, uint8_t found);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
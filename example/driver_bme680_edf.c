@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_edf.c
+ * @brief     driver bme680 edf source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bme680_edf.h"
+
+/**
+ * @brief      edf example init
+ * @param[out] *edf pointer to an edf structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t bme680_edf_init(bme680_edf_t *edf)
+{
+    edf->count = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      edf example add one sensor
+ * @param[in]  *edf pointer to an edf structure
+ * @param[in]  *handle pointer to an initialized bme680 handle structure
+ * @param[in]  period_us release period in us
+ * @param[in]  start_us first release time in us
+ * @param[out] *index pointer to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get measurement duration failed
+ *             - 2 sensor table is full
+ *             - 3 period is shorter than the conversion duration
+ * @note       the duration is computed once from the current sensor configuration,
+ *             the deadline of each job is the next release
+ */
+uint8_t bme680_edf_add(bme680_edf_t *edf, bme680_handle_t *handle, uint32_t period_us, uint64_t start_us, uint8_t *index)
+{
+    uint32_t duration_us;
+    bme680_edf_sensor_t *sensor;
+    
+    /* check the table */
+    if (edf->count >= BME680_EDF_MAX_SENSORS)
+    {
+        return 2;
+    }
+    
+    /* get the conversion duration */
+    if (bme680_get_measurement_duration(handle, (uint32_t *)&duration_us) != 0)
+    {
+        return 1;
+    }
+    if (period_us <= duration_us)
+    {
+        return 3;
+    }
+    
+    /* add the sensor */
+    sensor = &edf->sensor[edf->count];
+    sensor->handle = handle;
+    sensor->period_us = period_us;
+    sensor->duration_us = duration_us;
+    sensor->release_us = start_us;
+    sensor->trigger_us = 0;
+    sensor->deadline_us = 0;
+    sensor->busy = 0;
+    sensor->completed = 0;
+    sensor->missed = 0;
+    *index = edf->count;
+    edf->count++;
+    
+    return 0;
+}
+
+/**
+ * @brief      edf example run the most urgent ready job
+ * @param[in]  *edf pointer to an edf structure
+ * @param[in]  now_us current time in us
+ * @param[out] *event pointer to an event buffer
+ * @param[out] *next_us pointer to a next job time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the ready jobs are the releases not triggered yet and the conversions older than their duration,
+ *             the one with the earliest deadline runs and a readout wins a tie because it frees its sensor,
+ *             a release not triggered before its deadline is dropped and counted as missed,
+ *             a readout after its deadline is counted as missed,
+ *             call it again at once while the event is not none, else sleep until next_us
+ */
+uint8_t bme680_edf_poll(bme680_edf_t *edf, uint64_t now_us, bme680_edf_event_t *event, uint64_t *next_us)
+{
+    uint8_t i;
+    uint8_t best;
+    uint8_t best_readout;
+    uint64_t best_deadline_us;
+    uint64_t deadline_us;
+    uint64_t ready_us;
+    uint32_t temperature_raw;
+    uint32_t pressure_raw;
+    uint32_t humidity_raw;
+    bme680_edf_sensor_t *sensor;
+    
+    /* find the ready job with the earliest deadline */
+    best = BME680_EDF_MAX_SENSORS;
+    best_readout = 0;
+    best_deadline_us = UINT64_MAX;
+    *next_us = UINT64_MAX;
+    for (i = 0; i < edf->count; i++)
+    {
+        sensor = &edf->sensor[i];
+        if (sensor->busy != 0)
+        {
+            /* readout job */
+            ready_us = sensor->trigger_us + sensor->duration_us;
+            if (ready_us > now_us)
+            {
+                *next_us = (ready_us < *next_us) ? ready_us : *next_us;
+                
+                continue;
+            }
+            if ((sensor->deadline_us < best_deadline_us) || ((sensor->deadline_us == best_deadline_us) && (best_readout == 0)))
+            {
+                best = i;
+                best_readout = 1;
+                best_deadline_us = sensor->deadline_us;
+            }
+        }
+        else
+        {
+            /* drop the releases whose deadline has passed */
+            while (sensor->release_us + sensor->period_us <= now_us)
+            {
+                sensor->release_us += sensor->period_us;
+                sensor->missed++;
+            }
+            
+            /* trigger job */
+            if (sensor->release_us > now_us)
+            {
+                *next_us = (sensor->release_us < *next_us) ? sensor->release_us : *next_us;
+                
+                continue;
+            }
+            deadline_us = sensor->release_us + sensor->period_us;
+            if (deadline_us < best_deadline_us)
+            {
+                best = i;
+                best_readout = 0;
+                best_deadline_us = deadline_us;
+            }
+        }
+    }
+    
+    /* no job is ready */
+    event->type = BME680_EDF_EVENT_NONE;
+    if (best == BME680_EDF_MAX_SENSORS)
+    {
+        return 0;
+    }
+    
+    /* run the job */
+    sensor = &edf->sensor[best];
+    event->index = best;
+    event->deadline_us = best_deadline_us;
+    event->release_us = best_deadline_us - sensor->period_us;
+    *next_us = now_us;
+    if (best_readout != 0)
+    {
+        sensor->busy = 0;
+        if (bme680_get_temperature_pressure_humidity(sensor->handle, (uint32_t *)&temperature_raw, &event->temperature_c,
+                                                     (uint32_t *)&pressure_raw, &event->pressure_pa,
+                                                     (uint32_t *)&humidity_raw, &event->humidity_percentage) != 0)
+        {
+            sensor->missed++;
+            
+            return 1;
+        }
+        if (now_us > sensor->deadline_us)
+        {
+            sensor->missed++;
+        }
+        else
+        {
+            sensor->completed++;
+        }
+        event->type = BME680_EDF_EVENT_SAMPLE;
+    }
+    else
+    {
+        sensor->release_us += sensor->period_us;
+        if (bme680_set_mode(sensor->handle, BME680_MODE_FORCED) != 0)
+        {
+            sensor->missed++;
+            
+            return 1;
+        }
+        sensor->trigger_us = now_us;
+        sensor->deadline_us = best_deadline_us;
+        sensor->busy = 1;
+        event->type = BME680_EDF_EVENT_TRIGGER;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      edf example get the statistics of one sensor
+ * @param[in]  *edf pointer to an edf structure
+ * @param[in]  index sensor index
+ * @param[out] *completed pointer to a completed conversion counter buffer
+ * @param[out] *missed pointer to a missed deadline counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 index is invalid
+ * @note       none
+ */
+uint8_t bme680_edf_get_statistics(bme680_edf_t *edf, uint8_t index, uint32_t *completed, uint32_t *missed)
+{
+    if (index >= edf->count)
+    {
+        return 1;
+    }
+    *completed = edf->sensor[index].completed;
+    *missed = edf->sensor[index].missed;
+    
+    return 0;
+}
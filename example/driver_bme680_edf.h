@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_edf.h
+ * @brief     driver bme680 edf header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BME680_EDF_H
+#define DRIVER_BME680_EDF_H
+
+#include "driver_bme680_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup bme680_example_driver
+ * @{
+ */
+
+/**
+ * @brief bme680 edf max sensors definition
+ */
+#define BME680_EDF_MAX_SENSORS        8        /**< 8 sensors */
+
+/**
+ * @brief bme680 edf event type enumeration definition
+ */
+typedef enum
+{
+    BME680_EDF_EVENT_NONE    = 0x00,        /**< no job is ready */
+    BME680_EDF_EVENT_TRIGGER = 0x01,        /**< one conversion is triggered */
+    BME680_EDF_EVENT_SAMPLE  = 0x02,        /**< one conversion is read */
+} bme680_edf_event_type_t;
+
+/**
+ * @brief bme680 edf sensor structure definition
+ */
+typedef struct bme680_edf_sensor_s
+{
+    bme680_handle_t *handle;         /**< initialized sensor handle */
+    uint32_t period_us;              /**< release period in us */
+    uint32_t duration_us;            /**< expected conversion duration in us */
+    uint64_t release_us;             /**< next release time in us */
+    uint64_t trigger_us;             /**< trigger time of the running conversion in us */
+    uint64_t deadline_us;            /**< deadline of the running conversion in us */
+    uint8_t busy;                    /**< conversion running flag */
+    uint32_t completed;              /**< completed conversion counter */
+    uint32_t missed;                 /**< missed deadline counter */
+} bme680_edf_sensor_t;
+
+/**
+ * @brief bme680 edf structure definition
+ */
+typedef struct bme680_edf_s
+{
+    bme680_edf_sensor_t sensor[BME680_EDF_MAX_SENSORS];        /**< sensor table */
+    uint8_t count;                                             /**< sensor number */
+} bme680_edf_t;
+
+/**
+ * @brief bme680 edf event structure definition
+ */
+typedef struct bme680_edf_event_s
+{
+    bme680_edf_event_type_t type;        /**< event type */
+    uint8_t index;                       /**< sensor index */
+    uint64_t release_us;                 /**< release time of the job in us */
+    uint64_t deadline_us;                /**< deadline of the job in us */
+    float temperature_c;                 /**< temperature in celsius */
+    float pressure_pa;                   /**< pressure in pa */
+    float humidity_percentage;           /**< humidity percentage */
+} bme680_edf_event_t;
+
+/**
+ * @brief      edf example init
+ * @param[out] *edf pointer to an edf structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t bme680_edf_init(bme680_edf_t *edf);
+
+/**
+ * @brief      edf example add one sensor
+ * @param[in]  *edf pointer to an edf structure
+ * @param[in]  *handle pointer to an initialized bme680 handle structure
+ * @param[in]  period_us release period in us
+ * @param[in]  start_us first release time in us
+ * @param[out] *index pointer to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get measurement duration failed
+ *             - 2 sensor table is full
+ *             - 3 period is shorter than the conversion duration
+ * @note       the duration is computed once from the current sensor configuration,
+ *             the deadline of each job is the next release
+ */
+uint8_t bme680_edf_add(bme680_edf_t *edf, bme680_handle_t *handle, uint32_t period_us, uint64_t start_us, uint8_t *index);
+
+/**
+ * @brief      edf example run the most urgent ready job
+ * @param[in]  *edf pointer to an edf structure
+ * @param[in]  now_us current time in us
+ * @param[out] *event pointer to an event buffer
+ * @param[out] *next_us pointer to a next job time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the ready jobs are the releases not triggered yet and the conversions older than their duration,
+ *             the one with the earliest deadline runs and a readout wins a tie because it frees its sensor,
+ *             a release not triggered before its deadline is dropped and counted as missed,
+ *             a readout after its deadline is counted as missed,
+ *             call it again at once while the event is not none, else sleep until next_us
+ */
+uint8_t bme680_edf_poll(bme680_edf_t *edf, uint64_t now_us, bme680_edf_event_t *event, uint64_t *next_us);
+
+/**
+ * @brief      edf example get the statistics of one sensor
+ * @param[in]  *edf pointer to an edf structure
+ * @param[in]  index sensor index
+ * @param[out] *completed pointer to a completed conversion counter buffer
+ * @param[out] *missed pointer to a missed deadline counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 index is invalid
+ * @note       none
+ */
+uint8_t bme680_edf_get_statistics(bme680_edf_t *edf, uint8_t index, uint32_t *completed, uint32_t *missed);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -35,9 +35,75 @@
  */
 
 #include "driver_bme680_gas.h"
+#include <string.h>
 
 static bme680_handle_t gs_handle;        /**< bme680 handle */
 
+/**
+ * @brief gas example adaptive gas wait structure definition
+ */
+typedef struct bme680_gas_adaptive_s
+{
+    uint16_t wait_ms;         /**< current gas wait */
+    uint16_t floor_ms;        /**< last not stable gas wait */
+    uint16_t streak;          /**< stable reads since the last change */
+} bme680_gas_adaptive_t;
+
+static bme680_gas_adaptive_t gs_adaptive[BME680_GAS_PROFILE_LEN];        /**< adaptive gas wait of each index */
+
+/**
+ * @brief     gas example set the heater of one index
+ * @param[in] degree_celsius input degree celsius
+ * @param[in] gas_wait_ms gas wait ms
+ * @param[in] index convert index
+ * @return    status code
+ *            - 0 success
+ *            - 1 set heater failed
+ * @note      none
+ */
+static uint8_t a_bme680_gas_set_heater(float degree_celsius, uint16_t gas_wait_ms, uint8_t index)
+{
+    uint8_t res;
+    uint8_t reg;
+    
+    /* set degree celsius */
+    res = bme680_resistance_heater_convert_to_register(&gs_handle, degree_celsius, &reg);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* set resistance heater */
+    res = bme680_set_resistance_heater(&gs_handle, index, reg);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* set gas wait */
+    res = bme680_gas_wait_convert_to_register(&gs_handle, gas_wait_ms, &reg);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* set gas wait */
+    res = bme680_set_gas_wait(&gs_handle, index, reg);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* set convert index */
+    res = bme680_set_convert_index(&gs_handle, index);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     gas example init
  * @param[in] interface chip interface
@@ -63,6 +129,9 @@ uint8_t bme680_gas_init(bme680_interface_t interface, bme680_address_t addr_pin)
     DRIVER_BME680_LINK_SPI_WRITE(&gs_handle, bme680_interface_spi_write);
     DRIVER_BME680_LINK_DELAY_MS(&gs_handle, bme680_interface_delay_ms);
     DRIVER_BME680_LINK_DEBUG_PRINT(&gs_handle, bme680_interface_debug_print);
+    DRIVER_BME680_LINK_BUS_LOCK(&gs_handle, bme680_interface_bus_lock);
+    DRIVER_BME680_LINK_BUS_UNLOCK(&gs_handle, bme680_interface_bus_unlock);
+    DRIVER_BME680_LINK_GET_TIME_MS(&gs_handle, bme680_interface_get_time_ms);
     
     /* set interface */
     res = bme680_set_interface(&gs_handle, interface);
@@ -171,6 +240,9 @@ uint8_t bme680_gas_init(bme680_interface_t interface, bme680_address_t addr_pin)
         return 1;
     }
     
+    /* reset the adaptive gas wait */
+    memset(gs_adaptive, 0, sizeof(gs_adaptive));
+    
     return 0;
 }
 
@@ -191,65 +263,209 @@ uint8_t bme680_gas_init(bme680_interface_t interface, bme680_address_t addr_pin)
 uint8_t bme680_gas_read(float degree_celsius, uint16_t gas_wait_ms, uint8_t index,
                         float *temperature, float *pressure, float *humidity_percentage, float *ohms)
 {
-    uint8_t res;
-    uint8_t reg;
-    uint32_t temperature_yaw;
-    uint32_t pressure_yaw;
-    uint32_t humidity_raw;
-    uint16_t adc_raw;
-    uint8_t adc_range;
-    uint8_t index_check;
+    bme680_sample_t sample;
     
-    /* set degree celsius */
-    res = bme680_resistance_heater_convert_to_register(&gs_handle, degree_celsius, &reg);
-    if (res != 0)
+    /* set the heater */
+    if (a_bme680_gas_set_heater(degree_celsius, gas_wait_ms, index) != 0)
     {
         return 1;
     }
     
-    /* set resistance heater */
-    res = bme680_set_resistance_heater(&gs_handle, index, reg);
-    if (res != 0)
+    /* read */
+    if (bme680_read_sample(&gs_handle, BME680_OUTPUT_ALL, &sample) != 0)
     {
         return 1;
     }
     
-    /* set gas wait */
-    res = bme680_gas_wait_convert_to_register(&gs_handle, gas_wait_ms, &reg);
-    if (res != 0)
+    /* check index */
+    if (sample.index != index)
     {
         return 1;
     }
+    *temperature = sample.temperature_c;
+    *pressure = sample.pressure_pa;
+    *humidity_percentage = sample.humidity_percentage;
+    *ohms = sample.ohms;
     
-    /* set gas wait */
-    res = bme680_set_gas_wait(&gs_handle, index, reg);
-    if (res != 0)
+    return 0;
+}
+
+/**
+ * @brief      gas example read with the adaptive gas wait
+ * @param[in]  degree_celsius input degree celsius
+ * @param[in]  max_gas_wait_ms max gas wait ms
+ * @param[in]  index convert index
+ * @param[out] *temperature pointer to a converted temperature buffer
+ * @param[out] *pressure pointer to a converted pressure buffer
+ * @param[out] *humidity_percentage pointer to a converted humidity percentage buffer
+ * @param[out] *ohms pointer to an ohms buffer
+ * @param[out] *gas_wait_ms pointer to a used gas wait ms buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 heater is not stable
+ * @note       each index starts at max_gas_wait_ms, after BME680_GAS_ADAPTIVE_STREAK stable reads the wait shrinks by 1/8,
+ *             a not stable read doubles the wait up to max_gas_wait_ms and the failed wait becomes the floor of the index,
+ *             the floors are cleared by bme680_gas_init
+ */
+uint8_t bme680_gas_adaptive_read(float degree_celsius, uint16_t max_gas_wait_ms, uint8_t index,
+                                 float *temperature, float *pressure, float *humidity_percentage, float *ohms,
+                                 uint16_t *gas_wait_ms)
+{
+    uint8_t res;
+    uint16_t next_ms;
+    bme680_sample_t sample;
+    bme680_gas_adaptive_t *adaptive;
+    
+    /* check index */
+    if (index >= BME680_GAS_PROFILE_LEN)
     {
         return 1;
     }
     
-    /* set convert index */
-    res = bme680_set_convert_index(&gs_handle, index);
-    if (res != 0)
+    /* start from the max wait */
+    adaptive = &gs_adaptive[index];
+    if ((adaptive->wait_ms == 0) || (adaptive->wait_ms > max_gas_wait_ms))
+    {
+        adaptive->wait_ms = max_gas_wait_ms;
+        adaptive->streak = 0;
+    }
+    
+    /* set the heater */
+    if (a_bme680_gas_set_heater(degree_celsius, adaptive->wait_ms, index) != 0)
     {
         return 1;
     }
+    *gas_wait_ms = adaptive->wait_ms;
     
     /* read */
-    if (bme680_read(&gs_handle, (uint32_t *)&temperature_yaw, 
-                    temperature, (uint32_t *)&pressure_yaw, pressure,
-                   (uint32_t *)&humidity_raw, humidity_percentage,
-                    &adc_raw, &adc_range, ohms, &index_check) != 0)
+    res = bme680_read_sample(&gs_handle, BME680_OUTPUT_ALL, &sample);
+    if (res == 7)
+    {
+        /* back off and never shrink to the failed wait again */
+        adaptive->floor_ms = adaptive->wait_ms;
+        next_ms = (adaptive->wait_ms > max_gas_wait_ms / 2) ? max_gas_wait_ms : (uint16_t)(adaptive->wait_ms * 2);
+        adaptive->wait_ms = next_ms;
+        adaptive->streak = 0;
+        
+        return 2;
+    }
+    if (res != 0)
     {
         return 1;
     }
     
     /* check index */
-    if (index_check != index)
+    if (sample.index != index)
     {
         return 1;
     }
     
+    /* shrink after enough stable reads */
+    adaptive->streak++;
+    if (adaptive->streak >= BME680_GAS_ADAPTIVE_STREAK)
+    {
+        next_ms = adaptive->wait_ms - (((adaptive->wait_ms / 8) != 0) ? (adaptive->wait_ms / 8) : 1);
+        if ((next_ms > adaptive->floor_ms) && (next_ms >= BME680_GAS_ADAPTIVE_MIN_MS))
+        {
+            adaptive->wait_ms = next_ms;
+        }
+        adaptive->streak = 0;
+    }
+    *temperature = sample.temperature_c;
+    *pressure = sample.pressure_pa;
+    *humidity_percentage = sample.humidity_percentage;
+    *ohms = sample.ohms;
+    
+    return 0;
+}
+
+/**
+ * @brief     gas example upload the heater profile
+ * @param[in] *degree_celsius pointer to a heater temperature buffer
+ * @param[in] *gas_wait_ms pointer to a gas wait buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 set profile failed
+ * @note      both buffers length must be BME680_GAS_PROFILE_LEN,
+ *            call it once before bme680_gas_scan
+ */
+uint8_t bme680_gas_set_profile(float *degree_celsius, uint16_t *gas_wait_ms)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t reg;
+    
+    for (i = 0; i < BME680_GAS_PROFILE_LEN; i++)
+    {
+        /* set resistance heater */
+        res = bme680_resistance_heater_convert_to_register(&gs_handle, degree_celsius[i], &reg);
+        if (res != 0)
+        {
+            return 1;
+        }
+        res = bme680_set_resistance_heater(&gs_handle, i, reg);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* set gas wait */
+        res = bme680_gas_wait_convert_to_register(&gs_handle, gas_wait_ms[i], &reg);
+        if (res != 0)
+        {
+            return 1;
+        }
+        res = bme680_set_gas_wait(&gs_handle, i, reg);
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      gas example scan all the heater set points
+ * @param[out] *ohms pointer to a gas resistance buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 scan failed
+ * @note       ohms length must be BME680_GAS_PROFILE_LEN,
+ *             each set point runs one forced conversion with the profile uploaded by bme680_gas_set_profile
+ *             and the gas index of the meas status must match the set point
+ */
+uint8_t bme680_gas_scan(float *ohms)
+{
+    uint8_t res;
+    uint8_t i;
+    bme680_sample_t sample;
+    
+    for (i = 0; i < BME680_GAS_PROFILE_LEN; i++)
+    {
+        /* set convert index */
+        res = bme680_set_convert_index(&gs_handle, i);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* read the gas only */
+        res = bme680_read_sample(&gs_handle, BME680_OUTPUT_GAS, &sample);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* check index */
+        if (sample.index != i)
+        {
+            return 1;
+        }
+        ohms[i] = sample.ohms;
+    }
+    
     return 0;
 }
 
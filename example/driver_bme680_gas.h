@@ -57,6 +57,17 @@ extern "C"{
 #define BME680_GAS_DEFAULT_FILTER                          BME680_FILTER_COEFF_15            /**< filter coeff 15 */
 #define BME680_GAS_DEFAULT_SPI_WIRE                        BME680_SPI_WIRE_4                 /**< spi wire 4 */
 
+/**
+ * @brief bme680 gas example heater profile definition
+ */
+#define BME680_GAS_PROFILE_LEN                             10                                /**< 10 heater set points */
+
+/**
+ * @brief bme680 gas example adaptive gas wait definition
+ */
+#define BME680_GAS_ADAPTIVE_STREAK                         8                                 /**< 8 stable reads before shrinking */
+#define BME680_GAS_ADAPTIVE_MIN_MS                         10                                /**< 10ms min gas wait */
+
 /**
  * @brief     gas example init
  * @param[in] interface chip interface
@@ -68,6 +79,52 @@ extern "C"{
  */
 uint8_t bme680_gas_init(bme680_interface_t interface, bme680_address_t addr_pin);
 
+/**
+ * @brief      gas example read with the adaptive gas wait
+ * @param[in]  degree_celsius input degree celsius
+ * @param[in]  max_gas_wait_ms max gas wait ms
+ * @param[in]  index convert index
+ * @param[out] *temperature pointer to a converted temperature buffer
+ * @param[out] *pressure pointer to a converted pressure buffer
+ * @param[out] *humidity_percentage pointer to a converted humidity percentage buffer
+ * @param[out] *ohms pointer to an ohms buffer
+ * @param[out] *gas_wait_ms pointer to a used gas wait ms buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 heater is not stable
+ * @note       each index starts at max_gas_wait_ms, after BME680_GAS_ADAPTIVE_STREAK stable reads the wait shrinks by 1/8,
+ *             a not stable read doubles the wait up to max_gas_wait_ms and the failed wait becomes the floor of the index,
+ *             the floors are cleared by bme680_gas_init
+ */
+uint8_t bme680_gas_adaptive_read(float degree_celsius, uint16_t max_gas_wait_ms, uint8_t index,
+                                 float *temperature, float *pressure, float *humidity_percentage, float *ohms,
+                                 uint16_t *gas_wait_ms);
+
+/**
+ * @brief     gas example upload the heater profile
+ * @param[in] *degree_celsius pointer to a heater temperature buffer
+ * @param[in] *gas_wait_ms pointer to a gas wait buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 set profile failed
+ * @note      both buffers length must be BME680_GAS_PROFILE_LEN,
+ *            call it once before bme680_gas_scan
+ */
+uint8_t bme680_gas_set_profile(float *degree_celsius, uint16_t *gas_wait_ms);
+
+/**
+ * @brief      gas example scan all the heater set points
+ * @param[out] *ohms pointer to a gas resistance buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 scan failed
+ * @note       ohms length must be BME680_GAS_PROFILE_LEN,
+ *             each set point runs one forced conversion with the profile uploaded by bme680_gas_set_profile
+ *             and the gas index of the meas status must match the set point
+ */
+uint8_t bme680_gas_scan(float *ohms);
+
 /**
  * @brief  gas example deinit
  * @return status code
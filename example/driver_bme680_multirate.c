@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_multirate.c
+ * @brief     driver bme680 multirate source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bme680_multirate.h"
+
+static bme680_handle_t gs_handle;                 /**< bme680 handle */
+static uint32_t gs_gas_every;                     /**< one gas frame every n frames */
+static uint32_t gs_sequence;                      /**< frame sequence */
+static bme680_bool_t gs_run_gas;                  /**< current run gas */
+static uint32_t gs_gas_frames;                    /**< gas frame counter */
+static uint32_t gs_run_gas_switches;              /**< run gas switch counter */
+
+/**
+ * @brief      multirate example init
+ * @param[in]  interface chip interface
+ * @param[in]  addr_pin chip address pin
+ * @param[in]  tph_rate_hz temperature pressure and humidity rate in hz
+ * @param[in]  gas_rate_hz gas rate in hz
+ * @param[in]  degree_celsius heater temperature in degree celsius
+ * @param[in]  gas_wait_ms heater wait time in ms
+ * @param[out] *period_us pointer to a frame period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ *             - 2 rate is invalid
+ * @note       the frame period is 1 / tph_rate_hz and every round(tph_rate_hz / gas_rate_hz) frame is a gas frame,
+ *             gas_rate_hz can't be larger than tph_rate_hz
+ */
+uint8_t bme680_multirate_init(bme680_interface_t interface, bme680_address_t addr_pin,
+                              float tph_rate_hz, float gas_rate_hz, float degree_celsius, uint16_t gas_wait_ms,
+                              uint32_t *period_us)
+{
+    uint8_t res;
+    uint8_t reg;
+    
+    /* check the rates */
+    if ((tph_rate_hz <= 0.0f) || (gas_rate_hz <= 0.0f) || (gas_rate_hz > tph_rate_hz))
+    {
+        bme680_interface_debug_print("bme680: rate is invalid.\n");
+        
+        return 2;
+    }
+    
+    /* link interface function */
+    DRIVER_BME680_LINK_INIT(&gs_handle, bme680_handle_t); 
+    DRIVER_BME680_LINK_IIC_INIT(&gs_handle, bme680_interface_iic_init);
+    DRIVER_BME680_LINK_IIC_DEINIT(&gs_handle, bme680_interface_iic_deinit);
+    DRIVER_BME680_LINK_IIC_READ(&gs_handle, bme680_interface_iic_read);
+    DRIVER_BME680_LINK_IIC_WRITE(&gs_handle, bme680_interface_iic_write);
+    DRIVER_BME680_LINK_SPI_INIT(&gs_handle, bme680_interface_spi_init);
+    DRIVER_BME680_LINK_SPI_DEINIT(&gs_handle, bme680_interface_spi_deinit);
+    DRIVER_BME680_LINK_SPI_READ(&gs_handle, bme680_interface_spi_read);
+    DRIVER_BME680_LINK_SPI_WRITE(&gs_handle, bme680_interface_spi_write);
+    DRIVER_BME680_LINK_DELAY_MS(&gs_handle, bme680_interface_delay_ms);
+    DRIVER_BME680_LINK_DEBUG_PRINT(&gs_handle, bme680_interface_debug_print);
+    DRIVER_BME680_LINK_BUS_LOCK(&gs_handle, bme680_interface_bus_lock);
+    DRIVER_BME680_LINK_BUS_UNLOCK(&gs_handle, bme680_interface_bus_unlock);
+    DRIVER_BME680_LINK_GET_TIME_MS(&gs_handle, bme680_interface_get_time_ms);
+    
+    /* set interface */
+    res = bme680_set_interface(&gs_handle, interface);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set interface failed.\n");
+       
+        return 1;
+    }
+    
+    /* set addr pin */
+    res = bme680_set_addr_pin(&gs_handle, addr_pin);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set addr pin failed.\n");
+       
+        return 1;
+    }
+    
+    /* bme680 init */
+    res = bme680_init(&gs_handle);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set default temperature oversampling */
+    res = bme680_set_temperature_oversampling(&gs_handle, BME680_MULTIRATE_DEFAULT_TEMPERATURE_OVERSAMPLING);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set temperature oversampling failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set default pressure oversampling */
+    res = bme680_set_pressure_oversampling(&gs_handle, BME680_MULTIRATE_DEFAULT_PRESSURE_OVERSAMPLING);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set pressure oversampling failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set default humidity oversampling */
+    res = bme680_set_humidity_oversampling(&gs_handle, BME680_MULTIRATE_DEFAULT_HUMIDITY_OVERSAMPLING);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set humidity oversampling failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set default filter */
+    res = bme680_set_filter(&gs_handle, BME680_MULTIRATE_DEFAULT_FILTER);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set filter failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set default spi wire */
+    res = bme680_set_spi_wire(&gs_handle, BME680_MULTIRATE_DEFAULT_SPI_WIRE);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set spi wire failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set the heater temperature */
+    res = bme680_set_heater_temperature(&gs_handle, BME680_MULTIRATE_DEFAULT_INDEX, degree_celsius);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set heater temperature failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set the gas wait */
+    res = bme680_gas_wait_convert_to_register(&gs_handle, gas_wait_ms, &reg);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: gas wait convert to register failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = bme680_set_gas_wait(&gs_handle, BME680_MULTIRATE_DEFAULT_INDEX, reg);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set gas wait failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set the convert index */
+    res = bme680_set_convert_index(&gs_handle, BME680_MULTIRATE_DEFAULT_INDEX);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set convert index failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* keep the heater enabled, run gas alone decides whether a frame heats */
+    res = bme680_set_heater_off(&gs_handle, BME680_BOOL_FALSE);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set heat off failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable run gas */
+    res = bme680_set_run_gas(&gs_handle, BME680_BOOL_FALSE);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set run gas failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set sleep mode */
+    res = bme680_set_mode(&gs_handle, BME680_MODE_SLEEP);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set mode failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* plan the frames */
+    gs_gas_every = (uint32_t)(tph_rate_hz / gas_rate_hz + 0.5f);
+    if (gs_gas_every == 0)
+    {
+        gs_gas_every = 1;
+    }
+    *period_us = (uint32_t)(1000000.0f / tph_rate_hz);
+    gs_sequence = 0;
+    gs_run_gas = BME680_BOOL_FALSE;
+    gs_gas_frames = 0;
+    gs_run_gas_switches = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      multirate example run the next planned frame
+ * @param[in]  timestamp_us frame timestamp in us
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 gas is invalid
+ * @note       call it once per frame period, a gas frame is longer than a temperature pressure and humidity frame
+ *             by the heater wait time, run gas is only switched when the planned frame type changes,
+ *             when 2 is returned the temperature pressure and humidity of the frame are still valid
+ */
+uint8_t bme680_multirate_step(uint64_t timestamp_us, bme680_multirate_frame_t *frame)
+{
+    uint8_t res;
+    uint8_t mask;
+    bme680_bool_t run_gas;
+    bme680_sample_t sample;
+    
+    /* plan the frame */
+    run_gas = ((gs_sequence % gs_gas_every) == 0) ? BME680_BOOL_TRUE : BME680_BOOL_FALSE;
+    mask = BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY;
+    if (run_gas == BME680_BOOL_TRUE)
+    {
+        mask |= BME680_OUTPUT_GAS;
+    }
+    
+    /* switch run gas only when the frame type changes */
+    if (run_gas != gs_run_gas)
+    {
+        res = bme680_set_run_gas(&gs_handle, run_gas);
+        if (res != 0)
+        {
+            return 1;
+        }
+        gs_run_gas = run_gas;
+        gs_run_gas_switches++;
+    }
+    
+    /* run one forced conversion */
+    res = bme680_read_sample(&gs_handle, mask, &sample);
+    if ((res != 0) && (res != 6) && (res != 7))
+    {
+        return 1;
+    }
+    
+    /* fill the frame */
+    frame->sequence = gs_sequence;
+    frame->timestamp_us = timestamp_us;
+    frame->mask = sample.mask;
+    frame->temperature_c = sample.temperature_c;
+    frame->pressure_pa = sample.pressure_pa;
+    frame->humidity_percentage = sample.humidity_percentage;
+    frame->ohms = ((sample.mask & BME680_OUTPUT_GAS) != 0) ? sample.ohms : 0.0f;
+    gs_sequence++;
+    if (run_gas == BME680_BOOL_TRUE)
+    {
+        gs_gas_frames++;
+    }
+    
+    return (res != 0) ? 2 : 0;
+}
+
+/**
+ * @brief      multirate example get the planned frames
+ * @param[out] *gas_every pointer to a frame number buffer of one gas frame
+ * @param[out] *gas_frames pointer to a gas frame counter buffer
+ * @param[out] *run_gas_switches pointer to a run gas switch counter buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t bme680_multirate_get_statistics(uint32_t *gas_every, uint32_t *gas_frames, uint32_t *run_gas_switches)
+{
+    *gas_every = gs_gas_every;
+    *gas_frames = gs_gas_frames;
+    *run_gas_switches = gs_run_gas_switches;
+    
+    return 0;
+}
+
+/**
+ * @brief  multirate example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t bme680_multirate_deinit(void)
+{
+    /* disable run gas */
+    if (bme680_set_run_gas(&gs_handle, BME680_BOOL_FALSE) != 0)
+    {
+        return 1;
+    }
+    
+    /* close bme680 */
+    if (bme680_deinit(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_multirate.h
+ * @brief     driver bme680 multirate header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BME680_MULTIRATE_H
+#define DRIVER_BME680_MULTIRATE_H
+
+#include "driver_bme680_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup bme680_example_driver
+ * @{
+ */
+
+/**
+ * @brief bme680 multirate example default definition
+ */
+#define BME680_MULTIRATE_DEFAULT_TEMPERATURE_OVERSAMPLING        BME680_OVERSAMPLING_x2            /**< temperature oversampling x2 */
+#define BME680_MULTIRATE_DEFAULT_PRESSURE_OVERSAMPLING           BME680_OVERSAMPLING_x4            /**< pressure oversampling x4 */
+#define BME680_MULTIRATE_DEFAULT_HUMIDITY_OVERSAMPLING           BME680_OVERSAMPLING_x1            /**< humidity oversampling x1 */
+#define BME680_MULTIRATE_DEFAULT_FILTER                          BME680_FILTER_COEFF_3             /**< filter coeff 3 */
+#define BME680_MULTIRATE_DEFAULT_SPI_WIRE                        BME680_SPI_WIRE_4                 /**< spi wire 4 */
+#define BME680_MULTIRATE_DEFAULT_INDEX                           0                                 /**< heater index 0 */
+
+/**
+ * @brief bme680 multirate frame structure definition
+ */
+typedef struct bme680_multirate_frame_s
+{
+    uint32_t sequence;                 /**< frame sequence number */
+    uint64_t timestamp_us;             /**< frame timestamp in us */
+    uint8_t mask;                      /**< valid outputs, the or of bme680_output_t */
+    float temperature_c;               /**< temperature in celsius */
+    float pressure_pa;                 /**< pressure in pa */
+    float humidity_percentage;         /**< humidity percentage */
+    float ohms;                        /**< gas resistance in ohms */
+} bme680_multirate_frame_t;
+
+/**
+ * @brief      multirate example init
+ * @param[in]  interface chip interface
+ * @param[in]  addr_pin chip address pin
+ * @param[in]  tph_rate_hz temperature pressure and humidity rate in hz
+ * @param[in]  gas_rate_hz gas rate in hz
+ * @param[in]  degree_celsius heater temperature in degree celsius
+ * @param[in]  gas_wait_ms heater wait time in ms
+ * @param[out] *period_us pointer to a frame period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ *             - 2 rate is invalid
+ * @note       the frame period is 1 / tph_rate_hz and every round(tph_rate_hz / gas_rate_hz) frame is a gas frame,
+ *             gas_rate_hz can't be larger than tph_rate_hz
+ */
+uint8_t bme680_multirate_init(bme680_interface_t interface, bme680_address_t addr_pin,
+                              float tph_rate_hz, float gas_rate_hz, float degree_celsius, uint16_t gas_wait_ms,
+                              uint32_t *period_us);
+
+/**
+ * @brief  multirate example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t bme680_multirate_deinit(void);
+
+/**
+ * @brief      multirate example run the next planned frame
+ * @param[in]  timestamp_us frame timestamp in us
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 gas is invalid
+ * @note       call it once per frame period, a gas frame is longer than a temperature pressure and humidity frame
+ *             by the heater wait time, run gas is only switched when the planned frame type changes,
+ *             when 2 is returned the temperature pressure and humidity of the frame are still valid
+ */
+uint8_t bme680_multirate_step(uint64_t timestamp_us, bme680_multirate_frame_t *frame);
+
+/**
+ * @brief      multirate example get the planned frames
+ * @param[out] *gas_every pointer to a frame number buffer of one gas frame
+ * @param[out] *gas_frames pointer to a gas frame counter buffer
+ * @param[out] *run_gas_switches pointer to a run gas switch counter buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t bme680_multirate_get_statistics(uint32_t *gas_every, uint32_t *gas_frames, uint32_t *run_gas_switches);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
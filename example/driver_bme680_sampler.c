@@ -0,0 +1,609 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_sampler.c
+ * @brief     driver bme680 sampler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bme680_sampler.h"
+#include <string.h>
+
+static bme680_handle_t gs_handle;                                                    /**< bme680 handle */
+static volatile bme680_sampler_frame_t gs_buffer[BME680_SAMPLER_BUFFER_SIZE];        /**< frame buffer */
+static volatile uint32_t gs_head;                                                    /**< buffer write point */
+static volatile uint32_t gs_tail;                                                    /**< buffer read point */
+static volatile uint8_t gs_busy;                                                     /**< conversion busy flag */
+static volatile uint32_t gs_sequence;                                                /**< trigger sequence */
+static volatile uint64_t gs_timestamp_us;                                            /**< trigger timestamp */
+static volatile uint32_t gs_overrun;                                                 /**< overrun counter */
+static volatile uint32_t gs_dropped;                                                 /**< dropped counter */
+static volatile uint32_t gs_failed;                                                  /**< failed counter */
+
+/**
+ * @brief      sampler example init
+ * @param[in]  interface chip interface
+ * @param[in]  addr_pin chip address pin
+ * @param[out] *duration_us pointer to a conversion duration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       the completion path must run at least duration_us after each trigger
+ */
+uint8_t bme680_sampler_init(bme680_interface_t interface, bme680_address_t addr_pin, uint32_t *duration_us)
+{
+    uint8_t res;
+    
+    /* link interface function */
+    DRIVER_BME680_LINK_INIT(&gs_handle, bme680_handle_t); 
+    DRIVER_BME680_LINK_IIC_INIT(&gs_handle, bme680_interface_iic_init);
+    DRIVER_BME680_LINK_IIC_DEINIT(&gs_handle, bme680_interface_iic_deinit);
+    DRIVER_BME680_LINK_IIC_READ(&gs_handle, bme680_interface_iic_read);
+    DRIVER_BME680_LINK_IIC_WRITE(&gs_handle, bme680_interface_iic_write);
+    DRIVER_BME680_LINK_SPI_INIT(&gs_handle, bme680_interface_spi_init);
+    DRIVER_BME680_LINK_SPI_DEINIT(&gs_handle, bme680_interface_spi_deinit);
+    DRIVER_BME680_LINK_SPI_READ(&gs_handle, bme680_interface_spi_read);
+    DRIVER_BME680_LINK_SPI_WRITE(&gs_handle, bme680_interface_spi_write);
+    DRIVER_BME680_LINK_DELAY_MS(&gs_handle, bme680_interface_delay_ms);
+    DRIVER_BME680_LINK_DEBUG_PRINT(&gs_handle, bme680_interface_debug_print);
+    DRIVER_BME680_LINK_BUS_LOCK(&gs_handle, bme680_interface_bus_lock);
+    DRIVER_BME680_LINK_BUS_UNLOCK(&gs_handle, bme680_interface_bus_unlock);
+    DRIVER_BME680_LINK_GET_TIME_MS(&gs_handle, bme680_interface_get_time_ms);
+    
+    /* set interface */
+    res = bme680_set_interface(&gs_handle, interface);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set interface failed.\n");
+       
+        return 1;
+    }
+    
+    /* set addr pin */
+    res = bme680_set_addr_pin(&gs_handle, addr_pin);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set addr pin failed.\n");
+       
+        return 1;
+    }
+    
+    /* bme680 init */
+    res = bme680_init(&gs_handle);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set default temperature oversampling */
+    res = bme680_set_temperature_oversampling(&gs_handle, BME680_SAMPLER_DEFAULT_TEMPERATURE_OVERSAMPLING);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set temperature oversampling failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set default pressure oversampling */
+    res = bme680_set_pressure_oversampling(&gs_handle, BME680_SAMPLER_DEFAULT_PRESSURE_OVERSAMPLING);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set pressure oversampling failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set default humidity oversampling */
+    res = bme680_set_humidity_oversampling(&gs_handle, BME680_SAMPLER_DEFAULT_HUMIDITY_OVERSAMPLING);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set humidity oversampling failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set default filter */
+    res = bme680_set_filter(&gs_handle, BME680_SAMPLER_DEFAULT_FILTER);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set filter failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set default spi wire */
+    res = bme680_set_spi_wire(&gs_handle, BME680_SAMPLER_DEFAULT_SPI_WIRE);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set spi wire failed.\n");
+        (void)bme680_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* enable heater off */
+    res = bme680_set_heater_off(&gs_handle, BME680_BOOL_TRUE);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set heat off failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* disable run gas */
+    res = bme680_set_run_gas(&gs_handle, BME680_BOOL_FALSE);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set run gas failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* set sleep mode */
+    res = bme680_set_mode(&gs_handle, BME680_MODE_SLEEP);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set mode failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* get measurement duration */
+    res = bme680_get_measurement_duration(&gs_handle, duration_us);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get measurement duration failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* reset the buffer and the statistics */
+    gs_head = 0;
+    gs_tail = 0;
+    gs_busy = 0;
+    gs_sequence = 0;
+    gs_timestamp_us = 0;
+    gs_overrun = 0;
+    gs_dropped = 0;
+    gs_failed = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler example trigger one forced conversion
+ * @param[in] timestamp_us trigger timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 trigger failed
+ *            - 2 last conversion is not completed
+ * @note      it runs a blocking bus transfer, so call it from the main loop after the period timer interrupt
+ */
+uint8_t bme680_sampler_trigger(uint64_t timestamp_us)
+{
+    /* check the last conversion */
+    if (gs_busy != 0)
+    {
+        gs_overrun++;
+        
+        return 2;
+    }
+    
+    /* start forced conversion */
+    if (bme680_set_mode(&gs_handle, BME680_MODE_FORCED) != 0)
+    {
+        gs_failed++;
+        
+        return 1;
+    }
+    
+    /* save the trigger */
+    gs_timestamp_us = timestamp_us;
+    gs_sequence++;
+    gs_busy = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  sampler example complete the triggered conversion
+ * @return status code
+ *         - 0 success
+ *         - 1 read failed
+ *         - 2 buffer is full
+ *         - 3 no conversion is triggered
+ * @note   it runs a blocking bus transfer, so call it from the main loop after the completion interrupt
+ */
+uint8_t bme680_sampler_complete(void)
+{
+    uint32_t temperature_raw;
+    uint32_t pressure_raw;
+    uint32_t humidity_raw;
+    float temperature_c;
+    float pressure_pa;
+    float humidity_percentage;
+    uint32_t index;
+    
+    /* check the trigger */
+    if (gs_busy == 0)
+    {
+        return 3;
+    }
+    
+    /* get the converted data */
+    if (bme680_get_temperature_pressure_humidity(&gs_handle, (uint32_t *)&temperature_raw, &temperature_c,
+                                                 (uint32_t *)&pressure_raw, &pressure_pa,
+                                                 (uint32_t *)&humidity_raw, &humidity_percentage) != 0)
+    {
+        gs_busy = 0;
+        gs_failed++;
+        
+        return 1;
+    }
+    gs_busy = 0;
+    
+    /* check the buffer */
+    if ((gs_head - gs_tail) >= BME680_SAMPLER_BUFFER_SIZE)
+    {
+        gs_dropped++;
+        
+        return 2;
+    }
+    
+    /* push the frame */
+    index = gs_head & (BME680_SAMPLER_BUFFER_SIZE - 1);
+    gs_buffer[index].sequence = gs_sequence;
+    gs_buffer[index].timestamp_us = gs_timestamp_us;
+    gs_buffer[index].temperature_c = temperature_c;
+    gs_buffer[index].pressure_pa = pressure_pa;
+    gs_buffer[index].humidity_percentage = humidity_percentage;
+    gs_head++;
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler example start the free running mode
+ * @param[in] timestamp_us first trigger timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 last conversion is not completed
+ * @note      don't mix it with bme680_sampler_trigger
+ */
+uint8_t bme680_sampler_continuous_start(uint64_t timestamp_us)
+{
+    /* check the last conversion */
+    if (gs_busy != 0)
+    {
+        gs_overrun++;
+        
+        return 2;
+    }
+    
+    /* start the free running mode */
+    if (bme680_start_continuous(&gs_handle, BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY) != 0)
+    {
+        gs_failed++;
+        
+        return 1;
+    }
+    
+    /* save the trigger */
+    gs_timestamp_us = timestamp_us;
+    gs_sequence++;
+    gs_busy = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler example read one frame in the free running mode
+ * @param[in] timestamp_us next trigger timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 buffer is full
+ *            - 3 free running mode is not started
+ *            - 4 frame is skipped
+ * @note      the driver triggers the next conversion right after the readout,
+ *            so timestamp_us is the trigger time of the next frame,
+ *            call it at least duration_us after the last call,
+ *            a frame which is not ready is counted as an overrun and a frame which fails to compensate as a failure,
+ *            both are skipped with 4 and only a bus or handle error stops the free running mode with 1
+ */
+uint8_t bme680_sampler_continuous_step(uint64_t timestamp_us)
+{
+    uint8_t res;
+    bme680_sample_t sample;
+    uint32_t sequence;
+    uint64_t last_us;
+    uint32_t index;
+    
+    /* check the free running mode */
+    if (gs_busy == 0)
+    {
+        return 3;
+    }
+    
+    /* read the frame and trigger the next one */
+    res = bme680_read_continuous(&gs_handle, &sample);
+    if (res == 5)
+    {
+        /* the frame is not ready, skip this tick */
+        gs_overrun++;
+        
+        return 4;
+    }
+    else if (res == 4)
+    {
+        /* drop the frame and keep running */
+        gs_failed++;
+        
+        return 4;
+    }
+    else if (res != 0)
+    {
+        (void)bme680_stop_continuous(&gs_handle);
+        gs_busy = 0;
+        gs_failed++;
+        
+        return 1;
+    }
+    
+    /* save the next trigger */
+    sequence = gs_sequence;
+    last_us = gs_timestamp_us;
+    gs_timestamp_us = timestamp_us;
+    gs_sequence++;
+    
+    /* check the buffer */
+    if ((gs_head - gs_tail) >= BME680_SAMPLER_BUFFER_SIZE)
+    {
+        gs_dropped++;
+        
+        return 2;
+    }
+    
+    /* push the frame */
+    index = gs_head & (BME680_SAMPLER_BUFFER_SIZE - 1);
+    gs_buffer[index].sequence = sequence;
+    gs_buffer[index].timestamp_us = last_us;
+    gs_buffer[index].temperature_c = sample.temperature_c;
+    gs_buffer[index].pressure_pa = sample.pressure_pa;
+    gs_buffer[index].humidity_percentage = sample.humidity_percentage;
+    gs_head++;
+    
+    return 0;
+}
+
+/**
+ * @brief  sampler example stop the free running mode
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   none
+ */
+uint8_t bme680_sampler_continuous_stop(void)
+{
+    /* wait for the last conversion */
+    if (bme680_stop_continuous(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    gs_busy = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      sampler example pop one frame
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is empty
+ * @note       none
+ */
+uint8_t bme680_sampler_pop(bme680_sampler_frame_t *frame)
+{
+    uint32_t index;
+    
+    /* check the buffer */
+    if (gs_head == gs_tail)
+    {
+        return 1;
+    }
+    
+    /* pop the frame */
+    index = gs_tail & (BME680_SAMPLER_BUFFER_SIZE - 1);
+    frame->sequence = gs_buffer[index].sequence;
+    frame->timestamp_us = gs_buffer[index].timestamp_us;
+    frame->temperature_c = gs_buffer[index].temperature_c;
+    frame->pressure_pa = gs_buffer[index].pressure_pa;
+    frame->humidity_percentage = gs_buffer[index].humidity_percentage;
+    gs_tail++;
+    
+    return 0;
+}
+
+/**
+ * @brief      sampler example pack one frame to the binary format
+ * @param[in]  *frame pointer to a frame buffer
+ * @param[out] *buf pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       buf length must be at least BME680_SAMPLER_FRAME_LEN,
+ *             the checksum is the low 8 bits of the sum of all previous bytes
+ */
+uint8_t bme680_sampler_pack(bme680_sampler_frame_t *frame, uint8_t *buf)
+{
+    uint8_t i;
+    uint8_t sum;
+    uint32_t word[4];
+    
+    /* copy the float bits */
+    memcpy(&word[0], &frame->temperature_c, sizeof(uint32_t));
+    memcpy(&word[1], &frame->pressure_pa, sizeof(uint32_t));
+    memcpy(&word[2], &frame->humidity_percentage, sizeof(uint32_t));
+    word[3] = frame->sequence;
+    
+    /* set the header */
+    buf[0] = 0xAA;
+    buf[1] = 0x55;
+    
+    /* set the sequence */
+    for (i = 0; i < 4; i++)
+    {
+        buf[2 + i] = (uint8_t)(word[3] >> (8 * i));
+    }
+    
+    /* set the timestamp */
+    for (i = 0; i < 8; i++)
+    {
+        buf[6 + i] = (uint8_t)(frame->timestamp_us >> (8 * i));
+    }
+    
+    /* set the temperature pressure and humidity */
+    for (i = 0; i < 12; i++)
+    {
+        buf[14 + i] = (uint8_t)(word[i / 4] >> (8 * (i % 4)));
+    }
+    
+    /* set the checksum */
+    sum = 0;
+    for (i = 0; i < BME680_SAMPLER_FRAME_LEN - 1; i++)
+    {
+        sum += buf[i];
+    }
+    buf[BME680_SAMPLER_FRAME_LEN - 1] = sum;
+    
+    return 0;
+}
+
+/**
+ * @brief      sampler example get the statistics
+ * @param[out] *overrun pointer to an overrun trigger counter buffer
+ * @param[out] *dropped pointer to a dropped frame counter buffer
+ * @param[out] *failed pointer to a failed read counter buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t bme680_sampler_get_statistics(uint32_t *overrun, uint32_t *dropped, uint32_t *failed)
+{
+    *overrun = gs_overrun;
+    *dropped = gs_dropped;
+    *failed = gs_failed;
+    
+    return 0;
+}
+
+/**
+ * @brief  sampler example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t bme680_sampler_deinit(void)
+{
+    /* set sleep mode */
+    if (bme680_set_mode(&gs_handle, BME680_MODE_SLEEP) != 0)
+    {
+        return 1;
+    }
+    
+    /* close bme680 */
+    if (bme680_deinit(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     sampler example enable or disable the data ready interrupt
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set data interrupt failed
+ *            - 2 interface is not spi
+ * @note      the interrupt is output on the sdo pin in the spi 3 wire mode,
+ *            so enabling switches the chip to the 3 wire mode and disabling switches it back to the 4 wire mode,
+ *            the host spi bus must follow the chip wire mode after this function
+ */
+uint8_t bme680_sampler_set_data_interrupt(bme680_bool_t enable)
+{
+    uint8_t res;
+    bme680_interface_t interface;
+    
+    /* check the interface */
+    res = bme680_get_interface(&gs_handle, &interface);
+    if (res != 0)
+    {
+        return 1;
+    }
+    if (interface != BME680_INTERFACE_SPI)
+    {
+        return 2;
+    }
+    
+    /* set the data interrupt before the wire, both are still read in the current wire mode */
+    res = bme680_set_spi_wire_3_data_interrupt(&gs_handle, enable);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set spi wire 3 data interrupt failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the spi wire */
+    res = bme680_set_spi_wire(&gs_handle, (enable == BME680_BOOL_TRUE) ? BME680_SPI_WIRE_3 : BME680_SPI_WIRE_4);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set spi wire failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,218 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_sampler.h
+ * @brief     driver bme680 sampler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BME680_SAMPLER_H
+#define DRIVER_BME680_SAMPLER_H
+
+#include "driver_bme680_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup bme680_example_driver
+ * @{
+ */
+
+/**
+ * @brief bme680 sampler example default definition
+ */
+#define BME680_SAMPLER_DEFAULT_TEMPERATURE_OVERSAMPLING        BME680_OVERSAMPLING_x2            /**< temperature oversampling x2 */
+#define BME680_SAMPLER_DEFAULT_PRESSURE_OVERSAMPLING           BME680_OVERSAMPLING_x4            /**< pressure oversampling x4 */
+#define BME680_SAMPLER_DEFAULT_HUMIDITY_OVERSAMPLING           BME680_OVERSAMPLING_x1            /**< humidity oversampling x1 */
+#define BME680_SAMPLER_DEFAULT_FILTER                          BME680_FILTER_COEFF_3             /**< filter coeff 3 */
+#define BME680_SAMPLER_DEFAULT_SPI_WIRE                        BME680_SPI_WIRE_4                 /**< spi wire 4 */
+
+/**
+ * @brief bme680 sampler buffer size definition
+ * @note  must be a power of 2
+ */
+#define BME680_SAMPLER_BUFFER_SIZE        64        /**< 64 frames */
+
+/**
+ * @brief bme680 sampler packed frame definition
+ * @note  0xAA 0x55, sequence(4), timestamp_us(8), temperature_c(4), pressure_pa(4),
+ *        humidity_percentage(4), checksum(1), all little endian and floats are ieee754
+ */
+#define BME680_SAMPLER_FRAME_LEN          27        /**< 27 bytes */
+
+/**
+ * @brief bme680 sampler frame structure definition
+ */
+typedef struct bme680_sampler_frame_s
+{
+    uint32_t sequence;                 /**< trigger sequence number */
+    uint64_t timestamp_us;             /**< trigger timestamp in us */
+    float temperature_c;               /**< temperature in celsius */
+    float pressure_pa;                 /**< pressure in pa */
+    float humidity_percentage;         /**< humidity percentage */
+} bme680_sampler_frame_t;
+
+/**
+ * @brief      sampler example init
+ * @param[in]  interface chip interface
+ * @param[in]  addr_pin chip address pin
+ * @param[out] *duration_us pointer to a conversion duration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       the completion path must run at least duration_us after each trigger
+ */
+uint8_t bme680_sampler_init(bme680_interface_t interface, bme680_address_t addr_pin, uint32_t *duration_us);
+
+/**
+ * @brief  sampler example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t bme680_sampler_deinit(void);
+
+/**
+ * @brief     sampler example enable or disable the data ready interrupt
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set data interrupt failed
+ *            - 2 interface is not spi
+ * @note      the interrupt is output on the sdo pin in the spi 3 wire mode,
+ *            so enabling switches the chip to the 3 wire mode and disabling switches it back to the 4 wire mode,
+ *            the host spi bus must follow the chip wire mode after this function
+ */
+uint8_t bme680_sampler_set_data_interrupt(bme680_bool_t enable);
+
+/**
+ * @brief     sampler example trigger one forced conversion
+ * @param[in] timestamp_us trigger timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 trigger failed
+ *            - 2 last conversion is not completed
+ * @note      it runs a blocking bus transfer, so call it from the main loop after the period timer interrupt
+ */
+uint8_t bme680_sampler_trigger(uint64_t timestamp_us);
+
+/**
+ * @brief  sampler example complete the triggered conversion
+ * @return status code
+ *         - 0 success
+ *         - 1 read failed
+ *         - 2 buffer is full
+ *         - 3 no conversion is triggered
+ * @note   it runs a blocking bus transfer, so call it from the main loop after the completion interrupt
+ */
+uint8_t bme680_sampler_complete(void);
+
+/**
+ * @brief     sampler example start the free running mode
+ * @param[in] timestamp_us first trigger timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 last conversion is not completed
+ * @note      don't mix it with bme680_sampler_trigger
+ */
+uint8_t bme680_sampler_continuous_start(uint64_t timestamp_us);
+
+/**
+ * @brief     sampler example read one frame in the free running mode
+ * @param[in] timestamp_us next trigger timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 buffer is full
+ *            - 3 free running mode is not started
+ *            - 4 frame is skipped
+ * @note      the driver triggers the next conversion right after the readout,
+ *            so timestamp_us is the trigger time of the next frame,
+ *            call it at least duration_us after the last call,
+ *            a frame which is not ready is counted as an overrun and a frame which fails to compensate as a failure,
+ *            both are skipped with 4 and only a bus or handle error stops the free running mode with 1
+ */
+uint8_t bme680_sampler_continuous_step(uint64_t timestamp_us);
+
+/**
+ * @brief  sampler example stop the free running mode
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   none
+ */
+uint8_t bme680_sampler_continuous_stop(void);
+
+/**
+ * @brief      sampler example pop one frame
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is empty
+ * @note       none
+ */
+uint8_t bme680_sampler_pop(bme680_sampler_frame_t *frame);
+
+/**
+ * @brief      sampler example pack one frame to the binary format
+ * @param[in]  *frame pointer to a frame buffer
+ * @param[out] *buf pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ * @note       buf length must be at least BME680_SAMPLER_FRAME_LEN,
+ *             the checksum is the low 8 bits of the sum of all previous bytes
+ */
+uint8_t bme680_sampler_pack(bme680_sampler_frame_t *frame, uint8_t *buf);
+
+/**
+ * @brief      sampler example get the statistics
+ * @param[out] *overrun pointer to an overrun trigger counter buffer
+ * @param[out] *dropped pointer to a dropped frame counter buffer
+ * @param[out] *failed pointer to a failed read counter buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t bme680_sampler_get_statistics(uint32_t *overrun, uint32_t *dropped, uint32_t *failed);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
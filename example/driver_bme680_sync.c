@@ -0,0 +1,317 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_sync.c
+ * @brief     driver bme680 sync source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bme680_sync.h"
+
+/**
+ * @brief     sync example init
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] batch bool value
+ * @return    status code
+ *            - 0 success
+ * @note      when batch is true the iic triggers go out in one bme680_interface_iic_write_batch call
+ */
+uint8_t bme680_sync_init(bme680_sync_t *sync, bme680_bool_t batch)
+{
+    sync->count = 0;
+    sync->batch = batch;
+    sync->batched = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      sync example add one sensor
+ * @param[in]  *sync pointer to a sync structure
+ * @param[in]  *handle pointer to an initialized bme680 handle structure
+ * @param[out] *index pointer to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ *             - 2 sensor table is full
+ * @note       the ctrl_meas value and the duration are read once from the current sensor configuration,
+ *             init the sync structure and add the sensors again after changing the oversampling
+ */
+uint8_t bme680_sync_add(bme680_sync_t *sync, bme680_handle_t *handle, uint8_t *index)
+{
+    uint8_t ctrl_meas;
+    uint32_t duration_us;
+    bme680_interface_t interface;
+    bme680_address_t addr_pin;
+    bme680_sync_sensor_t *sensor;
+    
+    /* check the table */
+    if (sync->count >= BME680_SYNC_MAX_SENSORS)
+    {
+        return 2;
+    }
+    
+    /* get the bus */
+    if (bme680_get_interface(handle, &interface) != 0)
+    {
+        return 1;
+    }
+    if (bme680_get_addr_pin(handle, &addr_pin) != 0)
+    {
+        return 1;
+    }
+    
+    /* get the ctrl_meas and set the forced mode */
+    if (bme680_get_reg(handle, 0x74, (uint8_t *)&ctrl_meas, 1) != 0)
+    {
+        return 1;
+    }
+    ctrl_meas &= ~(3 << 0);
+    ctrl_meas |= 1 << 0;
+    
+    /* get the conversion duration */
+    if (bme680_get_measurement_duration(handle, (uint32_t *)&duration_us) != 0)
+    {
+        return 1;
+    }
+    
+    /* add the sensor */
+    sensor = &sync->sensor[sync->count];
+    sensor->handle = handle;
+    sensor->interface = interface;
+    sensor->iic_addr = (uint8_t)addr_pin;
+    sensor->ctrl_meas = ctrl_meas;
+    sensor->duration_us = duration_us;
+    sensor->trigger_us = 0;
+    sensor->skew_us = 0;
+    *index = sync->count;
+    sync->count++;
+    
+    return 0;
+}
+
+/**
+ * @brief      sync example trigger all sensors
+ * @param[in]  *sync pointer to a sync structure
+ * @param[out] *max_skew_us pointer to a max skew buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 trigger failed
+ *             - 2 no sensor is added
+ * @note       the iic sensors with different addresses are batched when enabled,
+ *             the others are written back to back and each trigger is timestamped when its write returns,
+ *             a batched trigger is timestamped by spreading the transfer time evenly over its messages
+ */
+uint8_t bme680_sync_trigger(bme680_sync_t *sync, uint32_t *max_skew_us)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t n;
+    uint8_t sent[BME680_SYNC_MAX_SENSORS];
+    uint8_t member[BME680_SYNC_MAX_SENSORS];
+    uint8_t addr[BME680_SYNC_MAX_SENSORS];
+    uint8_t value[BME680_SYNC_MAX_SENSORS];
+    uint64_t start_us;
+    uint64_t stop_us;
+    uint64_t first_us;
+    bme680_sync_sensor_t *sensor;
+    
+    /* check the table */
+    if (sync->count == 0)
+    {
+        return 2;
+    }
+    
+    /* pick the iic sensors that can share one transfer */
+    n = 0;
+    for (i = 0; i < sync->count; i++)
+    {
+        sent[i] = 0;
+        sensor = &sync->sensor[i];
+        if ((sync->batch == BME680_BOOL_FALSE) || (sensor->interface != BME680_INTERFACE_IIC))
+        {
+            continue;
+        }
+        for (j = 0; j < n; j++)
+        {
+            if (addr[j] == sensor->iic_addr)
+            {
+                break;
+            }
+        }
+        if (j == n)
+        {
+            member[n] = i;
+            addr[n] = sensor->iic_addr;
+            value[n] = sensor->ctrl_meas;
+            n++;
+        }
+    }
+    
+    /* a single sensor gains nothing from the batch */
+    if (n < 2)
+    {
+        n = 0;
+    }
+    
+    /* send the batch */
+    if (n != 0)
+    {
+        if (bme680_interface_bus_lock(sync->sensor[member[0]].handle) != 0)
+        {
+            return 1;
+        }
+        start_us = bme680_interface_get_time_us();
+        if (bme680_interface_iic_write_batch((uint8_t *)addr, 0x74, (uint8_t *)value, n) != 0)
+        {
+            (void)bme680_interface_bus_unlock(sync->sensor[member[0]].handle);
+            
+            return 1;
+        }
+        stop_us = bme680_interface_get_time_us();
+        (void)bme680_interface_bus_unlock(sync->sensor[member[0]].handle);
+        for (j = 0; j < n; j++)
+        {
+            sensor = &sync->sensor[member[j]];
+            sensor->trigger_us = start_us + (stop_us - start_us) * (j + 1) / n;
+            sent[member[j]] = 1;
+        }
+    }
+    sync->batched = n;
+    
+    /* send the others back to back */
+    for (i = 0; i < sync->count; i++)
+    {
+        if (sent[i] != 0)
+        {
+            continue;
+        }
+        sensor = &sync->sensor[i];
+        if (bme680_set_reg(sensor->handle, 0x74, (uint8_t *)&sensor->ctrl_meas, 1) != 0)
+        {
+            return 1;
+        }
+        sensor->trigger_us = bme680_interface_get_time_us();
+    }
+    
+    /* compute the skew */
+    first_us = UINT64_MAX;
+    for (i = 0; i < sync->count; i++)
+    {
+        if (sync->sensor[i].trigger_us < first_us)
+        {
+            first_us = sync->sensor[i].trigger_us;
+        }
+    }
+    *max_skew_us = 0;
+    for (i = 0; i < sync->count; i++)
+    {
+        sensor = &sync->sensor[i];
+        sensor->skew_us = (uint32_t)(sensor->trigger_us - first_us);
+        if (sensor->skew_us > *max_skew_us)
+        {
+            *max_skew_us = sensor->skew_us;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      sync example get the trigger time of one sensor
+ * @param[in]  *sync pointer to a sync structure
+ * @param[in]  index sensor index
+ * @param[out] *trigger_us pointer to a trigger time buffer
+ * @param[out] *skew_us pointer to a skew buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 index is invalid
+ * @note       the skew is the trigger delay to the first sensor of the last round
+ */
+uint8_t bme680_sync_get_trigger(bme680_sync_t *sync, uint8_t index, uint64_t *trigger_us, uint32_t *skew_us)
+{
+    if (index >= sync->count)
+    {
+        return 1;
+    }
+    *trigger_us = sync->sensor[index].trigger_us;
+    *skew_us = sync->sensor[index].skew_us;
+    
+    return 0;
+}
+
+/**
+ * @brief      sync example read one sensor of the last round
+ * @param[in]  *sync pointer to a sync structure
+ * @param[in]  index sensor index
+ * @param[out] *temperature pointer to a converted temperature buffer
+ * @param[out] *pressure pointer to a converted pressure buffer
+ * @param[out] *humidity_percentage pointer to a converted humidity percentage buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 index is invalid
+ * @note       it waits until the conversion of the sensor is due before reading
+ */
+uint8_t bme680_sync_read(bme680_sync_t *sync, uint8_t index, float *temperature, float *pressure, float *humidity_percentage)
+{
+    uint32_t temperature_raw;
+    uint32_t pressure_raw;
+    uint32_t humidity_raw;
+    uint64_t due_us;
+    uint64_t now_us;
+    bme680_sync_sensor_t *sensor;
+    
+    /* check the index */
+    if (index >= sync->count)
+    {
+        return 2;
+    }
+    sensor = &sync->sensor[index];
+    
+    /* wait for the conversion */
+    due_us = sensor->trigger_us + sensor->duration_us;
+    now_us = bme680_interface_get_time_us();
+    if (now_us < due_us)
+    {
+        bme680_interface_delay_ms((uint32_t)((due_us - now_us + 999) / 1000));
+    }
+    
+    /* read the data */
+    if (bme680_get_temperature_pressure_humidity(sensor->handle, (uint32_t *)&temperature_raw, temperature,
+                                                 (uint32_t *)&pressure_raw, pressure,
+                                                 (uint32_t *)&humidity_raw, humidity_percentage) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
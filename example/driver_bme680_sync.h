@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_sync.h
+ * @brief     driver bme680 sync header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BME680_SYNC_H
+#define DRIVER_BME680_SYNC_H
+
+#include "driver_bme680_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup bme680_example_driver
+ * @{
+ */
+
+/**
+ * @brief bme680 sync max sensors definition
+ */
+#define BME680_SYNC_MAX_SENSORS        8        /**< 8 sensors */
+
+/**
+ * @brief bme680 sync sensor structure definition
+ */
+typedef struct bme680_sync_sensor_s
+{
+    bme680_handle_t *handle;         /**< initialized sensor handle */
+    bme680_interface_t interface;    /**< sensor interface */
+    uint8_t iic_addr;                /**< iic device write address */
+    uint8_t ctrl_meas;               /**< ctrl_meas value with the forced mode */
+    uint32_t duration_us;            /**< expected conversion duration in us */
+    uint64_t trigger_us;             /**< trigger time of the last round in us */
+    uint32_t skew_us;                /**< trigger delay to the first sensor of the last round in us */
+} bme680_sync_sensor_t;
+
+/**
+ * @brief bme680 sync structure definition
+ */
+typedef struct bme680_sync_s
+{
+    bme680_sync_sensor_t sensor[BME680_SYNC_MAX_SENSORS];        /**< sensor table */
+    uint8_t count;                                               /**< sensor number */
+    bme680_bool_t batch;                                         /**< batch iic write flag */
+    uint8_t batched;                                             /**< sensors sent in one batch in the last round */
+} bme680_sync_t;
+
+/**
+ * @brief     sync example init
+ * @param[in] *sync pointer to a sync structure
+ * @param[in] batch bool value
+ * @return    status code
+ *            - 0 success
+ * @note      when batch is true the iic triggers go out in one bme680_interface_iic_write_batch call
+ */
+uint8_t bme680_sync_init(bme680_sync_t *sync, bme680_bool_t batch);
+
+/**
+ * @brief      sync example add one sensor
+ * @param[in]  *sync pointer to a sync structure
+ * @param[in]  *handle pointer to an initialized bme680 handle structure
+ * @param[out] *index pointer to a sensor index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ *             - 2 sensor table is full
+ * @note       the ctrl_meas value and the duration are read once from the current sensor configuration,
+ *             init the sync structure and add the sensors again after changing the oversampling
+ */
+uint8_t bme680_sync_add(bme680_sync_t *sync, bme680_handle_t *handle, uint8_t *index);
+
+/**
+ * @brief      sync example trigger all sensors
+ * @param[in]  *sync pointer to a sync structure
+ * @param[out] *max_skew_us pointer to a max skew buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 trigger failed
+ *             - 2 no sensor is added
+ * @note       the iic sensors with different addresses are batched when enabled,
+ *             the others are written back to back and each trigger is timestamped when its write returns,
+ *             a batched trigger is timestamped by spreading the transfer time evenly over its messages
+ */
+uint8_t bme680_sync_trigger(bme680_sync_t *sync, uint32_t *max_skew_us);
+
+/**
+ * @brief      sync example get the trigger time of one sensor
+ * @param[in]  *sync pointer to a sync structure
+ * @param[in]  index sensor index
+ * @param[out] *trigger_us pointer to a trigger time buffer
+ * @param[out] *skew_us pointer to a skew buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 index is invalid
+ * @note       the skew is the trigger delay to the first sensor of the last round
+ */
+uint8_t bme680_sync_get_trigger(bme680_sync_t *sync, uint8_t index, uint64_t *trigger_us, uint32_t *skew_us);
+
+/**
+ * @brief      sync example read one sensor of the last round
+ * @param[in]  *sync pointer to a sync structure
+ * @param[in]  index sensor index
+ * @param[out] *temperature pointer to a converted temperature buffer
+ * @param[out] *pressure pointer to a converted pressure buffer
+ * @param[out] *humidity_percentage pointer to a converted humidity percentage buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 index is invalid
+ * @note       it waits until the conversion of the sensor is due before reading
+ */
+uint8_t bme680_sync_read(bme680_sync_t *sync, uint8_t index, float *temperature, float *pressure, float *humidity_percentage);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
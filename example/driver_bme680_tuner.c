@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_tuner.c
+ * @brief     driver bme680 tuner source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bme680_tuner.h"
+#include <math.h>
+
+/**
+ * @brief bme680 tuner candidate number definition
+ */
+#define BME680_TUNER_OVERSAMPLING_NUM        (BME680_OVERSAMPLING_x16 - BME680_OVERSAMPLING_x1 + 1)        /**< x1 - x16 */
+#define BME680_TUNER_FILTER_NUM              (BME680_TUNER_MAX_FILTER - BME680_FILTER_OFF + 1)             /**< off - max filter */
+
+/**
+ * @brief     tuner example apply one configuration
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] temperature temperature oversampling
+ * @param[in] pressure pressure oversampling
+ * @param[in] humidity humidity oversampling
+ * @param[in] filter filter
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply failed
+ * @note      none
+ */
+static uint8_t a_bme680_tuner_apply(bme680_handle_t *handle, bme680_oversampling_t temperature,
+                                    bme680_oversampling_t pressure, bme680_oversampling_t humidity, bme680_filter_t filter)
+{
+    if ((bme680_set_temperature_oversampling(handle, temperature) != 0) ||
+        (bme680_set_pressure_oversampling(handle, pressure) != 0) ||
+        (bme680_set_humidity_oversampling(handle, humidity) != 0) ||
+        (bme680_set_filter(handle, filter) != 0))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      tuner example measure the noise of the current configuration
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  period_us sample period in us
+ * @param[in]  warmup dropped samples before the measurement
+ * @param[out] *noise pointer to a temperature, pressure and humidity noise buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 measure failed
+ * @note       none
+ */
+static uint8_t a_bme680_tuner_measure(bme680_handle_t *handle, uint32_t period_us, uint8_t warmup, float *noise)
+{
+    uint8_t i;
+    uint8_t j;
+    uint32_t duration_us;
+    float mean;
+    float sum;
+    float value[3][BME680_TUNER_SAMPLES];
+    bme680_sample_t sample;
+    
+    /* get the gap between two samples */
+    if (bme680_get_measurement_duration(handle, (uint32_t *)&duration_us) != 0)
+    {
+        return 1;
+    }
+    
+    /* sample at the target rate */
+    for (i = 0; i < warmup + BME680_TUNER_SAMPLES; i++)
+    {
+        if (bme680_read_sample(handle, BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY,
+                               &sample) != 0)
+        {
+            return 1;
+        }
+        if (i >= warmup)
+        {
+            value[0][i - warmup] = sample.temperature_c;
+            value[1][i - warmup] = sample.pressure_pa;
+            value[2][i - warmup] = sample.humidity_percentage;
+        }
+        if (period_us > duration_us)
+        {
+            bme680_interface_delay_ms((period_us - duration_us) / 1000);
+        }
+    }
+    
+    /* get the standard deviation */
+    for (j = 0; j < 3; j++)
+    {
+        sum = 0.0f;
+        for (i = 0; i < BME680_TUNER_SAMPLES; i++)
+        {
+            sum += value[j][i];
+        }
+        mean = sum / BME680_TUNER_SAMPLES;
+        sum = 0.0f;
+        for (i = 0; i < BME680_TUNER_SAMPLES; i++)
+        {
+            sum += (value[j][i] - mean) * (value[j][i] - mean);
+        }
+        noise[j] = sqrtf(sum / (BME680_TUNER_SAMPLES - 1));
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      tuner example pick and apply the fastest configuration meeting the noise targets
+ * @param[in]  *handle pointer to an initialized bme680 handle structure
+ * @param[in]  rate_hz target sample rate in hz
+ * @param[in]  temperature_noise_c max temperature rms noise
+ * @param[in]  pressure_noise_pa max pressure rms noise
+ * @param[in]  humidity_noise_percentage max humidity rms noise
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 no configuration meets the targets
+ * @note       every oversampling from x1 to x16 is measured with every filter up to BME680_TUNER_MAX_FILTER,
+ *             the samples are taken at rate_hz after a warm up of 2 * coeff + 1 samples and the noise is the
+ *             standard deviation of BME680_TUNER_SAMPLES samples, so the sensor must rest during the tuning,
+ *             among the configurations of the same duration the smaller filter wins because it keeps the step response,
+ *             the original configuration is restored when 1 or 2 is returned
+ */
+uint8_t bme680_tuner_run(bme680_handle_t *handle, float rate_hz,
+                         float temperature_noise_c, float pressure_noise_pa, float humidity_noise_percentage,
+                         bme680_tuner_result_t *result)
+{
+    uint8_t f;
+    uint8_t o;
+    uint8_t j;
+    uint8_t found;
+    uint8_t chosen[3];
+    uint32_t period_us;
+    uint32_t duration_us;
+    float target[3];
+    float noise[BME680_TUNER_FILTER_NUM][BME680_TUNER_OVERSAMPLING_NUM][3];
+    bme680_oversampling_t original[3];
+    bme680_filter_t original_filter;
+    
+    /* save the original configuration */
+    if ((rate_hz <= 0.0f) ||
+        (bme680_get_temperature_oversampling(handle, &original[0]) != 0) ||
+        (bme680_get_pressure_oversampling(handle, &original[1]) != 0) ||
+        (bme680_get_humidity_oversampling(handle, &original[2]) != 0) ||
+        (bme680_get_filter(handle, &original_filter) != 0))
+    {
+        return 1;
+    }
+    period_us = (uint32_t)(1000000.0f / rate_hz);
+    target[0] = temperature_noise_c;
+    target[1] = pressure_noise_pa;
+    target[2] = humidity_noise_percentage;
+    
+    /* measure every candidate with the same oversampling for all quantities */
+    for (f = 0; f < BME680_TUNER_FILTER_NUM; f++)
+    {
+        for (o = 0; o < BME680_TUNER_OVERSAMPLING_NUM; o++)
+        {
+            if ((a_bme680_tuner_apply(handle, (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + o),
+                                      (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + o),
+                                      (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + o),
+                                      (bme680_filter_t)(BME680_FILTER_OFF + f)) != 0) ||
+                (a_bme680_tuner_measure(handle, period_us, (uint8_t)(2 * ((1 << f) - 1) + 1), noise[f][o]) != 0))
+            {
+                (void)a_bme680_tuner_apply(handle, original[0], original[1], original[2], original_filter);
+                
+                return 1;
+            }
+        }
+    }
+    
+    /* pick the smallest oversampling of each quantity per filter and keep the fastest fitting one */
+    found = 0;
+    for (f = 0; f < BME680_TUNER_FILTER_NUM; f++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            for (o = 0; o < BME680_TUNER_OVERSAMPLING_NUM; o++)
+            {
+                if (noise[f][o][j] <= target[j])
+                {
+                    break;
+                }
+            }
+            chosen[j] = o;
+        }
+        if ((chosen[0] == BME680_TUNER_OVERSAMPLING_NUM) || (chosen[1] == BME680_TUNER_OVERSAMPLING_NUM) ||
+            (chosen[2] == BME680_TUNER_OVERSAMPLING_NUM))
+        {
+            continue;
+        }
+        if ((a_bme680_tuner_apply(handle, (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + chosen[0]),
+                                  (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + chosen[1]),
+                                  (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + chosen[2]),
+                                  (bme680_filter_t)(BME680_FILTER_OFF + f)) != 0) ||
+            (bme680_get_measurement_duration(handle, (uint32_t *)&duration_us) != 0))
+        {
+            (void)a_bme680_tuner_apply(handle, original[0], original[1], original[2], original_filter);
+            
+            return 1;
+        }
+        if ((duration_us > period_us) || ((found != 0) && (duration_us >= result->duration_us)))
+        {
+            continue;
+        }
+        found = 1;
+        result->temperature_oversampling = (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + chosen[0]);
+        result->pressure_oversampling = (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + chosen[1]);
+        result->humidity_oversampling = (bme680_oversampling_t)(BME680_OVERSAMPLING_x1 + chosen[2]);
+        result->filter = (bme680_filter_t)(BME680_FILTER_OFF + f);
+        result->temperature_noise_c = noise[f][chosen[0]][0];
+        result->pressure_noise_pa = noise[f][chosen[1]][1];
+        result->humidity_noise_percentage = noise[f][chosen[2]][2];
+        result->duration_us = duration_us;
+    }
+    
+    /* apply the result */
+    if (found == 0)
+    {
+        (void)a_bme680_tuner_apply(handle, original[0], original[1], original[2], original_filter);
+        
+        return 2;
+    }
+    if (a_bme680_tuner_apply(handle, result->temperature_oversampling, result->pressure_oversampling,
+                             result->humidity_oversampling, result->filter) != 0)
+    {
+        (void)a_bme680_tuner_apply(handle, original[0], original[1], original[2], original_filter);
+        
+        return 1;
+    }
+    
+    return 0;
+}
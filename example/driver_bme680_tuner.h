@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bme680_tuner.h
+ * @brief     driver bme680 tuner header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BME680_TUNER_H
+#define DRIVER_BME680_TUNER_H
+
+#include "driver_bme680_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup bme680_example_driver
+ * @{
+ */
+
+/**
+ * @brief bme680 tuner example default definition
+ */
+#define BME680_TUNER_DEFAULT_TEMPERATURE_NOISE_C              0.01f                     /**< 0.01C rms */
+#define BME680_TUNER_DEFAULT_PRESSURE_NOISE_PA                2.0f                      /**< 2Pa rms */
+#define BME680_TUNER_DEFAULT_HUMIDITY_NOISE_PERCENTAGE        0.05f                     /**< 0.05% rms */
+
+/**
+ * @brief bme680 tuner example search definition
+ */
+#define BME680_TUNER_SAMPLES                                  16                        /**< 16 samples per noise measurement */
+#define BME680_TUNER_MAX_FILTER                               BME680_FILTER_COEFF_15    /**< filter coeff 15 is the slowest candidate */
+
+/**
+ * @brief bme680 tuner result structure definition
+ */
+typedef struct bme680_tuner_result_s
+{
+    bme680_oversampling_t temperature_oversampling;        /**< chosen temperature oversampling */
+    bme680_oversampling_t pressure_oversampling;           /**< chosen pressure oversampling */
+    bme680_oversampling_t humidity_oversampling;           /**< chosen humidity oversampling */
+    bme680_filter_t filter;                                /**< chosen filter */
+    float temperature_noise_c;                             /**< measured temperature rms noise */
+    float pressure_noise_pa;                               /**< measured pressure rms noise */
+    float humidity_noise_percentage;                       /**< measured humidity rms noise */
+    uint32_t duration_us;                                  /**< expected conversion duration in us */
+} bme680_tuner_result_t;
+
+/**
+ * @brief      tuner example pick and apply the fastest configuration meeting the noise targets
+ * @param[in]  *handle pointer to an initialized bme680 handle structure
+ * @param[in]  rate_hz target sample rate in hz
+ * @param[in]  temperature_noise_c max temperature rms noise
+ * @param[in]  pressure_noise_pa max pressure rms noise
+ * @param[in]  humidity_noise_percentage max humidity rms noise
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 no configuration meets the targets
+ * @note       every oversampling from x1 to x16 is measured with every filter up to BME680_TUNER_MAX_FILTER,
+ *             the samples are taken at rate_hz after a warm up of 2 * coeff + 1 samples and the noise is the
+ *             standard deviation of BME680_TUNER_SAMPLES samples, so the sensor must rest during the tuning,
+ *             among the configurations of the same duration the smaller filter wins because it keeps the step response,
+ *             the original configuration is restored when 1 or 2 is returned
+ */
+uint8_t bme680_tuner_run(bme680_handle_t *handle, float rate_hz,
+                         float temperature_noise_c, float pressure_noise_pa, float humidity_noise_percentage,
+                         bme680_tuner_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -94,6 +94,19 @@ uint8_t bme680_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t bme680_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     interface iic bus write one register of several devices
+ * @param[in] *addr pointer to an iic device write address buffer
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer with one byte per device
+ * @param[in] count device number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the writes are issued back to back in the address order
+ */
+uint8_t bme680_interface_iic_write_batch(uint8_t *addr, uint8_t reg, uint8_t *buf, uint8_t count);
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -136,6 +149,16 @@ uint8_t bme680_interface_spi_read(uint8_t reg, uint8_t *buf, uint16_t len);
  */
 uint8_t bme680_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     interface spi bus enable or disable the 3 wire mode
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set 3 wire failed
+ * @note      it is used by the data ready interrupt which needs the chip in the spi 3 wire mode
+ */
+uint8_t bme680_interface_spi_set_3_wire(uint8_t enable);
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -150,6 +173,40 @@ void bme680_interface_delay_ms(uint32_t ms);
  */
 void bme680_interface_debug_print(const char *const fmt, ...);
 
+/**
+ * @brief     interface bus lock
+ * @param[in] *handle pointer to the bme680 handle which takes the bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      none
+ */
+uint8_t bme680_interface_bus_lock(bme680_handle_t *handle);
+
+/**
+ * @brief     interface bus unlock
+ * @param[in] *handle pointer to the bme680 handle which releases the bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      none
+ */
+uint8_t bme680_interface_bus_unlock(bme680_handle_t *handle);
+
+/**
+ * @brief  interface get time ms
+ * @return monotonic time in ms
+ * @note   none
+ */
+uint32_t bme680_interface_get_time_ms(void);
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t bme680_interface_get_time_us(void);
+
 /**
  * @}
  */
@@ -38,6 +38,8 @@
 #include "iic.h"
 #include "spi.h"
 #include <stdarg.h>
+#include <pthread.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -59,16 +61,59 @@ static int gs_iic_fd;                       /**< iic handle */
  */
 static int gs_spi_fd;                       /**< spi handle */
 
+/**
+ * @brief bus user counter definition
+ */
+static uint32_t gs_iic_users = 0;           /**< iic handle users */
+static uint32_t gs_spi_users = 0;           /**< spi handle users */
+
+/**
+ * @brief bus mutex definition
+ */
+static pthread_mutex_t gs_iic_mutex = PTHREAD_MUTEX_INITIALIZER;          /**< iic bus mutex */
+static pthread_mutex_t gs_spi_mutex = PTHREAD_MUTEX_INITIALIZER;          /**< spi bus mutex */
+static pthread_mutex_t gs_users_mutex = PTHREAD_MUTEX_INITIALIZER;        /**< bus user counter mutex */
+
+/**
+ * @brief     get the mutex of the handle bus
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    pointer to a bus mutex
+ * @note      none
+ */
+static pthread_mutex_t *a_bme680_interface_bus_mutex(bme680_handle_t *handle)
+{
+    if (handle->iic_spi == BME680_INTERFACE_SPI)
+    {
+        return &gs_spi_mutex;
+    }
+    
+    return &gs_iic_mutex;
+}
+
 /**
  * @brief  interface iic bus init
  * @return status code
  *         - 0 success
  *         - 1 iic init failed
- * @note   none
+ * @note   the device is opened by the first user and shared by the others
  */
 uint8_t bme680_interface_iic_init(void)
 {
-    return iic_init(IIC_DEVICE_NAME, &gs_iic_fd);
+    uint8_t res;
+    
+    res = 0;
+    (void)pthread_mutex_lock(&gs_users_mutex);
+    if (gs_iic_users == 0)
+    {
+        res = iic_init(IIC_DEVICE_NAME, &gs_iic_fd);
+    }
+    if (res == 0)
+    {
+        gs_iic_users++;
+    }
+    (void)pthread_mutex_unlock(&gs_users_mutex);
+    
+    return (res != 0) ? 1 : 0;
 }
 
 /**
@@ -76,11 +121,29 @@ uint8_t bme680_interface_iic_init(void)
  * @return status code
  *         - 0 success
  *         - 1 iic deinit failed
- * @note   none
+ * @note   the device is closed by the last user
  */
 uint8_t bme680_interface_iic_deinit(void)
-{   
-    return iic_deinit(gs_iic_fd);
+{
+    uint8_t res;
+    
+    res = 0;
+    (void)pthread_mutex_lock(&gs_users_mutex);
+    if (gs_iic_users == 0)
+    {
+        res = 1;
+    }
+    else
+    {
+        gs_iic_users--;
+        if (gs_iic_users == 0)
+        {
+            res = iic_deinit(gs_iic_fd);
+        }
+    }
+    (void)pthread_mutex_unlock(&gs_users_mutex);
+    
+    return (res != 0) ? 1 : 0;
 }
 
 /**
@@ -115,16 +178,46 @@ uint8_t bme680_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(gs_iic_fd, addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus write one register of several devices
+ * @param[in] *addr pointer to an iic device write address buffer
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer with one byte per device
+ * @param[in] count device number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      all writes go out in one I2C_RDWR transfer joined by repeated starts
+ */
+uint8_t bme680_interface_iic_write_batch(uint8_t *addr, uint8_t reg, uint8_t *buf, uint8_t count)
+{
+    return iic_write_batch(gs_iic_fd, addr, reg, buf, count);
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
  *         - 0 success
  *         - 1 spi init failed
- * @note   none
+ * @note   the device is opened by the first user and shared by the others
  */
 uint8_t bme680_interface_spi_init(void)
 {
-    return spi_init(SPI_DEVICE_NAME, &gs_spi_fd, SPI_MODE_TYPE_3, 1000 * 1000);
+    uint8_t res;
+    
+    res = 0;
+    (void)pthread_mutex_lock(&gs_users_mutex);
+    if (gs_spi_users == 0)
+    {
+        res = spi_init(SPI_DEVICE_NAME, &gs_spi_fd, SPI_MODE_TYPE_3, 1000 * 1000);
+    }
+    if (res == 0)
+    {
+        gs_spi_users++;
+    }
+    (void)pthread_mutex_unlock(&gs_users_mutex);
+    
+    return (res != 0) ? 1 : 0;
 }
 
 /**
@@ -132,11 +225,29 @@ uint8_t bme680_interface_spi_init(void)
  * @return status code
  *         - 0 success
  *         - 1 spi deinit failed
- * @note   none
+ * @note   the device is closed by the last user
  */
 uint8_t bme680_interface_spi_deinit(void)
-{   
-    return spi_deinit(gs_spi_fd);
+{
+    uint8_t res;
+    
+    res = 0;
+    (void)pthread_mutex_lock(&gs_users_mutex);
+    if (gs_spi_users == 0)
+    {
+        res = 1;
+    }
+    else
+    {
+        gs_spi_users--;
+        if (gs_spi_users == 0)
+        {
+            res = spi_deinit(gs_spi_fd);
+        }
+    }
+    (void)pthread_mutex_unlock(&gs_users_mutex);
+    
+    return (res != 0) ? 1 : 0;
 }
 
 /**
@@ -169,6 +280,19 @@ uint8_t bme680_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
     return spi_write(gs_spi_fd, reg, buf, len);
 }
 
+/**
+ * @brief     interface spi bus enable or disable the 3 wire mode
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set 3 wire failed
+ * @note      it is used by the data ready interrupt which needs the chip in the spi 3 wire mode
+ */
+uint8_t bme680_interface_spi_set_3_wire(uint8_t enable)
+{
+    return spi_set_3_wire(gs_spi_fd, enable);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -196,3 +320,68 @@ void bme680_interface_debug_print(const char *const fmt, ...)
     
     (void)printf((uint8_t *)str);
 }
+
+/**
+ * @brief     interface bus lock
+ * @param[in] *handle pointer to the bme680 handle which takes the bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      the iic and the spi bus have their own mutex, so each driver call is
+ *            atomic against other handles on the same bus only
+ */
+uint8_t bme680_interface_bus_lock(bme680_handle_t *handle)
+{
+    if (pthread_mutex_lock(a_bme680_interface_bus_mutex(handle)) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     interface bus unlock
+ * @param[in] *handle pointer to the bme680 handle which releases the bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      none
+ */
+uint8_t bme680_interface_bus_unlock(bme680_handle_t *handle)
+{
+    if (pthread_mutex_unlock(a_bme680_interface_bus_mutex(handle)) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  interface get time ms
+ * @return monotonic time in ms
+ * @note   none
+ */
+uint32_t bme680_interface_get_time_ms(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t bme680_interface_get_time_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
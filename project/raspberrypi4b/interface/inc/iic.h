@@ -142,6 +142,21 @@ uint8_t iic_write_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len);
  */
 uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     iic bus write one register of several devices
+ * @param[in] fd iic handle
+ * @param[in] *addr pointer to an iic device write address buffer
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer with one byte per device
+ * @param[in] count device number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      addr = device_address_7bits << 1,
+ *            all writes go out in one I2C_RDWR transfer joined by repeated starts
+ */
+uint8_t iic_write_batch(int fd, uint8_t *addr, uint8_t reg, uint8_t *buf, uint8_t count);
+
 /**
  * @brief     iic bus write with 16 bits register address
  * @param[in] fd iic handle
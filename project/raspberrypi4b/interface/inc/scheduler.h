@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scheduler.h
+ * @brief     scheduler header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup scheduler scheduler function
+ * @brief    scheduler function modules
+ * @{
+ */
+
+/**
+ * @brief scheduler align enumeration definition
+ */
+typedef enum
+{
+    SCHEDULER_ALIGN_NONE   = 0x00,        /**< the first deadline is now */
+    SCHEDULER_ALIGN_SECOND = 0x01,        /**< the first deadline is the next wall clock second */
+} scheduler_align_t;
+
+/**
+ * @brief scheduler structure definition
+ */
+typedef struct scheduler_s
+{
+    uint64_t period_ns;             /**< period in ns */
+    uint64_t next_ns;               /**< next monotonic deadline in ns */
+    uint32_t ticks;                 /**< served deadline counter */
+    uint32_t missed;                /**< missed deadline counter */
+    uint64_t lateness_min_ns;       /**< min wake up lateness in ns */
+    uint64_t lateness_max_ns;       /**< max wake up lateness in ns */
+    double lateness_sum_ns;         /**< sum of the wake up lateness in ns */
+    double lateness_sum_sq_ns;      /**< sum of the squared wake up lateness in ns */
+} scheduler_t;
+
+/**
+ * @brief scheduler statistics structure definition
+ */
+typedef struct scheduler_statistics_s
+{
+    uint32_t ticks;             /**< served deadline counter */
+    uint32_t missed;            /**< missed deadline counter */
+    double jitter_min_us;       /**< min wake up lateness in us */
+    double jitter_max_us;       /**< max wake up lateness in us */
+    double jitter_mean_us;      /**< mean wake up lateness in us */
+    double jitter_std_us;       /**< standard deviation of the wake up lateness in us */
+} scheduler_statistics_t;
+
+/**
+ * @brief  scheduler get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+uint64_t scheduler_get_time_ns(void);
+
+/**
+ * @brief     scheduler init
+ * @param[in] *sched pointer to a scheduler structure
+ * @param[in] period_ns period in ns
+ * @param[in] align first deadline alignment
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t scheduler_init(scheduler_t *sched, uint64_t period_ns, scheduler_align_t align);
+
+/**
+ * @brief      scheduler wait for the next deadline
+ * @param[in]  *sched pointer to a scheduler structure
+ * @param[out] *deadline_ns pointer to a deadline buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ *             - 2 interrupted by a signal
+ * @note       the deadlines are absolute so the period never drifts,
+ *             the deadlines which have already passed are skipped and counted as missed
+ */
+uint8_t scheduler_wait(scheduler_t *sched, uint64_t *deadline_ns);
+
+/**
+ * @brief      scheduler get the statistics
+ * @param[in]  *sched pointer to a scheduler structure
+ * @param[out] *statistics pointer to a statistics structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t scheduler_get_statistics(scheduler_t *sched, scheduler_statistics_t *statistics);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
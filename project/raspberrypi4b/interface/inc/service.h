@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      service.h
+ * @brief     service header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SERVICE_H
+#define SERVICE_H
+
+#include "driver_bme680.h"
+#include <pthread.h>
+#include <semaphore.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup service service function
+ * @brief    service function modules
+ * @{
+ */
+
+/**
+ * @brief service request type enumeration definition
+ */
+typedef enum
+{
+    SERVICE_REQUEST_TYPE_READ_TPH = 0x00,        /**< read temperature pressure and humidity */
+    SERVICE_REQUEST_TYPE_READ     = 0x01,        /**< read temperature pressure humidity and gas */
+    SERVICE_REQUEST_TYPE_CUSTOM   = 0x02,        /**< run a custom operation */
+} service_request_type_t;
+
+/**
+ * @brief service request structure definition
+ */
+typedef struct service_request_s
+{
+    struct service_request_s *next;                                        /**< queue link */
+    bme680_handle_t *handle;                                               /**< target bme680 handle */
+    service_request_type_t type;                                           /**< request type */
+    uint8_t (*op)(bme680_handle_t *handle, void *arg);                     /**< custom operation */
+    void *arg;                                                             /**< custom operation arg */
+    void (*callback)(struct service_request_s *request);                   /**< completion callback */
+    void *user;                                                            /**< user data */
+    uint8_t status;                                                        /**< completion status */
+    float temperature_c;                                                   /**< temperature result */
+    float pressure_pa;                                                     /**< pressure result */
+    float humidity_percentage;                                             /**< humidity result */
+    float ohms;                                                            /**< gas resistance result */
+    uint8_t index;                                                         /**< gas index result */
+    sem_t done;                                                            /**< completion future */
+} service_request_t;
+
+/**
+ * @brief service structure definition
+ */
+typedef struct service_s
+{
+    service_request_t *head;               /**< submission queue head written by the producers */
+    service_request_t *tail;               /**< submission queue tail read by the worker */
+    service_request_t stub;                /**< submission queue stub node */
+    service_request_t *pending;            /**< request popped by the worker but not run yet */
+    sem_t wake;                            /**< worker wake up */
+    pthread_t thread;                      /**< worker thread */
+    int stop;                              /**< stop flag */
+    uint32_t submitters;                   /**< submit calls in progress */
+    uint32_t completed;                    /**< completed request counter */
+    uint32_t failed;                       /**< failed request counter */
+    uint32_t coalesced;                    /**< request counter completed by an in-flight conversion */
+} service_t;
+
+/**
+ * @brief     service init and start the worker thread
+ * @param[in] *service pointer to a service structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      one service per bus, all the bme680 calls of the handles on the bus must be submitted to the service after this
+ */
+uint8_t service_init(service_t *service);
+
+/**
+ * @brief     service stop the worker thread and deinit
+ * @param[in] *service pointer to a service structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      the submitted requests are completed before the worker exits and later submits are rejected
+ */
+uint8_t service_deinit(service_t *service);
+
+/**
+ * @brief     service request init
+ * @param[in] *request pointer to a service request structure
+ * @param[in] *handle pointer to an initialized bme680 handle structure on the service bus
+ * @param[in] type request type
+ * @param[in] *op pointer to a custom operation and it is only used by the custom type
+ * @param[in] *arg pointer to the custom operation arg
+ * @param[in] *callback pointer to a completion callback and NULL means none
+ * @param[in] *user pointer to the user data
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the callback runs in the worker thread and must not block
+ */
+uint8_t service_request_init(service_request_t *request, bme680_handle_t *handle, service_request_type_t type,
+                             uint8_t (*op)(bme680_handle_t *handle, void *arg), void *arg,
+                             void (*callback)(service_request_t *request), void *user);
+
+/**
+ * @brief     service request deinit
+ * @param[in] *request pointer to a service request structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t service_request_deinit(service_request_t *request);
+
+/**
+ * @brief     service submit a request
+ * @param[in] *service pointer to a service structure
+ * @param[in] *request pointer to a service request structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      it never blocks and it can be called from any thread,
+ *            the request must stay valid until it is completed,
+ *            read requests of the same handle queued behind a running read attach to it and get the same sample
+ */
+uint8_t service_submit(service_t *service, service_request_t *request);
+
+/**
+ * @brief     service wait for a request completion
+ * @param[in] *request pointer to a service request structure
+ * @param[in] timeout_ms timeout in ms and 0 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 timeout
+ * @note      the request result is valid after this returns 0, check request->status for the driver result
+ */
+uint8_t service_wait(service_request_t *request, uint32_t timeout_ms);
+
+/**
+ * @brief      service get the statistics
+ * @param[in]  *service pointer to a service structure
+ * @param[out] *completed pointer to a completed request counter buffer
+ * @param[out] *failed pointer to a failed request counter buffer
+ * @param[out] *coalesced pointer to a coalesced request counter buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the coalesced requests are included in the completed requests
+ */
+uint8_t service_get_statistics(service_t *service, uint32_t *completed, uint32_t *failed, uint32_t *coalesced);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -88,6 +88,18 @@ uint8_t spi_init(char *name, int *fd, spi_mode_type_t mode, uint32_t freq);
  */
 uint8_t spi_deinit(int fd);
 
+/**
+ * @brief     spi bus enable or disable the 3 wire mode
+ * @param[in] fd spi handle
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set 3 wire failed
+ * @note      in the 3 wire mode mosi is used as the bidirectional data line,
+ *            the mode is cached here so spi_read doesn't query it for every transfer
+ */
+uint8_t spi_set_3_wire(int fd, uint8_t enable);
+
 /**
  * @brief      spi bus read command
  * @param[in]  fd spi handle
@@ -109,7 +121,7 @@ uint8_t spi_read_cmd(int fd, uint8_t *buf, uint16_t len);
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       in the 3 wire mode set by spi_set_3_wire the address and the data are sent as two transfers
  */
 uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len);
 
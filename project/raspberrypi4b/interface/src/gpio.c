@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio.c
+ * @brief     gpio source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpio.h"
+#include <gpiod.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief gpio device name definition
+ */
+#define GPIO_DEVICE_NAME "gpiochip0"        /**< gpio device name */
+
+/**
+ * @brief gpio device line definition
+ */
+#define GPIO_DEVICE_LINE 17                 /**< gpio device line */
+
+/**
+ * @brief gpio consumer name definition
+ */
+#define GPIO_CONSUMER_NAME "bme680"         /**< gpio consumer name */
+
+static struct gpiod_chip *gs_chip = NULL;   /**< gpio chip handle */
+static struct gpiod_line *gs_line = NULL;   /**< gpio line handle */
+
+/**
+ * @brief  gpio interrupt init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   gpio pin is GPIO17(BCM) and the rising edge is requested
+ */
+uint8_t gpio_interrupt_init(void)
+{
+    /* open the gpio chip */
+    gs_chip = gpiod_chip_open_by_name(GPIO_DEVICE_NAME);
+    if (gs_chip == NULL)
+    {
+        perror("gpio: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* get the gpio line */
+    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
+    if (gs_line == NULL)
+    {
+        perror("gpio: get line failed.\n");
+        gpiod_chip_close(gs_chip);
+        gs_chip = NULL;
+        
+        return 1;
+    }
+    
+    /* request the rising edge events */
+    if (gpiod_line_request_rising_edge_events(gs_line, GPIO_CONSUMER_NAME) < 0)
+    {
+        perror("gpio: request rising edge events failed.\n");
+        gpiod_chip_close(gs_chip);
+        gs_chip = NULL;
+        gs_line = NULL;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t gpio_interrupt_deinit(void)
+{
+    /* check the chip */
+    if (gs_chip == NULL)
+    {
+        return 1;
+    }
+    
+    /* release the line and close the chip */
+    gpiod_line_release(gs_line);
+    gpiod_chip_close(gs_chip);
+    gs_chip = NULL;
+    gs_line = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio interrupt wait for one edge
+ * @param[in]  timeout_ms timeout in ms
+ * @param[out] *timestamp_ns pointer to an edge timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ *             - 2 timeout
+ * @note       the timestamp is the kernel event time
+ */
+uint8_t gpio_interrupt_wait(uint32_t timeout_ms, uint64_t *timestamp_ns)
+{
+    int res;
+    struct timespec ts;
+    struct gpiod_line_event event;
+    
+    /* check the line */
+    if (gs_line == NULL)
+    {
+        return 1;
+    }
+    
+    /* wait for the event */
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+    res = gpiod_line_event_wait(gs_line, &ts);
+    if (res < 0)
+    {
+        return 1;
+    }
+    else if (res == 0)
+    {
+        return 2;
+    }
+    
+    /* read the event */
+    if (gpiod_line_event_read(gs_line, &event) < 0)
+    {
+        return 1;
+    }
+    *timestamp_ns = (uint64_t)event.ts.tv_sec * 1000000000ULL + (uint64_t)event.ts.tv_nsec;
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt clear the pending edges
+ * @return status code
+ *         - 0 success
+ *         - 1 clear failed
+ * @note   none
+ */
+uint8_t gpio_interrupt_clear(void)
+{
+    uint64_t timestamp_ns;
+    
+    /* check the line */
+    if (gs_line == NULL)
+    {
+        return 1;
+    }
+    
+    /* read until no edge is pending */
+    while (gpio_interrupt_wait(0, &timestamp_ns) == 0)
+    {
+        
+    }
+    
+    return 0;
+}
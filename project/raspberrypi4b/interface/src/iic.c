@@ -315,6 +315,62 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief     iic bus write one register of several devices
+ * @param[in] fd iic handle
+ * @param[in] *addr pointer to an iic device write address buffer
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer with one byte per device
+ * @param[in] count device number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      addr = device_address_7bits << 1,
+ *            all writes go out in one I2C_RDWR transfer joined by repeated starts
+ */
+uint8_t iic_write_batch(int fd, uint8_t *addr, uint8_t reg, uint8_t *buf, uint8_t count)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    uint8_t buf_send[I2C_RDWR_IOCTL_MAX_MSGS][2];
+    uint8_t i;
+    
+    /* check the count */
+    if ((count == 0) || (count > I2C_RDWR_IOCTL_MAX_MSGS))
+    {
+        return 1;
+    }
+    
+    /* clear ioctl data */
+    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
+    
+    /* clear msgs data */
+    memset(msgs, 0, sizeof(struct i2c_msg) * count);
+    
+    /* set the param */
+    for (i = 0; i < count; i++)
+    {
+        msgs[i].addr = addr[i] >> 1;
+        msgs[i].flags = 0;
+        buf_send[i][0] = reg;
+        buf_send[i][1] = buf[i];
+        msgs[i].buf = buf_send[i];
+        msgs[i].len = 2;
+    }
+    i2c_rdwr_data.msgs = msgs;
+    i2c_rdwr_data.nmsgs = count;
+    
+    /* transmit */
+    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    {
+        perror("iic: write batch failed.\n");
+        
+        return 1;
+    }
+     
+    return 0;
+}
+
 /**
  * @brief     iic bus write with 16 bits register address
  * @param[in] fd iic handle
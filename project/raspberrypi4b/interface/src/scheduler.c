@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scheduler.c
+ * @brief     scheduler source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "scheduler.h"
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief  scheduler get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+uint64_t scheduler_get_time_ns(void)
+{
+    struct timespec ts;
+    
+    /* get the time */
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     scheduler init
+ * @param[in] *sched pointer to a scheduler structure
+ * @param[in] period_ns period in ns
+ * @param[in] align first deadline alignment
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t scheduler_init(scheduler_t *sched, uint64_t period_ns, scheduler_align_t align)
+{
+    struct timespec ts;
+    
+    /* check the period */
+    if (period_ns == 0)
+    {
+        return 1;
+    }
+    
+    /* set the first deadline */
+    sched->period_ns = period_ns;
+    sched->next_ns = scheduler_get_time_ns();
+    if (align == SCHEDULER_ALIGN_SECOND)
+    {
+        if (clock_gettime(CLOCK_REALTIME, &ts) != 0)
+        {
+            return 1;
+        }
+        if (ts.tv_nsec != 0)
+        {
+            sched->next_ns += 1000000000ULL - (uint64_t)ts.tv_nsec;
+        }
+    }
+    
+    /* clear the statistics */
+    sched->ticks = 0;
+    sched->missed = 0;
+    sched->lateness_min_ns = UINT64_MAX;
+    sched->lateness_max_ns = 0;
+    sched->lateness_sum_ns = 0.0;
+    sched->lateness_sum_sq_ns = 0.0;
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler wait for the next deadline
+ * @param[in]  *sched pointer to a scheduler structure
+ * @param[out] *deadline_ns pointer to a deadline buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wait failed
+ *             - 2 interrupted by a signal
+ * @note       the deadlines are absolute so the period never drifts,
+ *             the deadlines which have already passed are skipped and counted as missed
+ */
+uint8_t scheduler_wait(scheduler_t *sched, uint64_t *deadline_ns)
+{
+    int res;
+    uint64_t now_ns;
+    uint64_t late_ns;
+    uint64_t missed;
+    struct timespec ts;
+    
+    /* sleep until the deadline */
+    ts.tv_sec = (time_t)(sched->next_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(sched->next_ns % 1000000000ULL);
+    res = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    if (res == EINTR)
+    {
+        return 2;
+    }
+    else if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* update the statistics */
+    now_ns = scheduler_get_time_ns();
+    late_ns = (now_ns > sched->next_ns) ? (now_ns - sched->next_ns) : 0;
+    if (late_ns < sched->lateness_min_ns)
+    {
+        sched->lateness_min_ns = late_ns;
+    }
+    if (late_ns > sched->lateness_max_ns)
+    {
+        sched->lateness_max_ns = late_ns;
+    }
+    sched->lateness_sum_ns += (double)late_ns;
+    sched->lateness_sum_sq_ns += (double)late_ns * (double)late_ns;
+    sched->ticks++;
+    
+    /* output the deadline and step to the next one */
+    *deadline_ns = sched->next_ns;
+    sched->next_ns += sched->period_ns;
+    
+    /* skip the passed deadlines */
+    if (now_ns >= sched->next_ns)
+    {
+        missed = (now_ns - sched->next_ns) / sched->period_ns + 1;
+        sched->next_ns += missed * sched->period_ns;
+        sched->missed += (uint32_t)missed;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler get the statistics
+ * @param[in]  *sched pointer to a scheduler structure
+ * @param[out] *statistics pointer to a statistics structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t scheduler_get_statistics(scheduler_t *sched, scheduler_statistics_t *statistics)
+{
+    double mean;
+    double var;
+    
+    /* clear the output */
+    memset(statistics, 0, sizeof(scheduler_statistics_t));
+    statistics->ticks = sched->ticks;
+    statistics->missed = sched->missed;
+    if (sched->ticks == 0)
+    {
+        return 0;
+    }
+    
+    /* calculate the jitter */
+    mean = sched->lateness_sum_ns / sched->ticks;
+    var = sched->lateness_sum_sq_ns / sched->ticks - mean * mean;
+    statistics->jitter_min_us = (double)sched->lateness_min_ns / 1000.0;
+    statistics->jitter_max_us = (double)sched->lateness_max_ns / 1000.0;
+    statistics->jitter_mean_us = mean / 1000.0;
+    statistics->jitter_std_us = ((var > 0.0) ? sqrt(var) : 0.0) / 1000.0;
+    
+    return 0;
+}
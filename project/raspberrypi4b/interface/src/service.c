@@ -0,0 +1,541 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      service.c
+ * @brief     service source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "service.h"
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief     service push a request to the submission queue
+ * @param[in] *service pointer to a service structure
+ * @param[in] *request pointer to a service request structure
+ * @note      multiple producers, wait free
+ */
+static void a_service_push(service_t *service, service_request_t *request)
+{
+    service_request_t *prev;
+    
+    /* link the request after the previous head */
+    __atomic_store_n(&request->next, NULL, __ATOMIC_RELAXED);
+    prev = __atomic_exchange_n(&service->head, request, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&prev->next, request, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief     service pop a request from the submission queue
+ * @param[in] *service pointer to a service structure
+ * @return    pointer to a service request structure and NULL means empty or a push is in progress
+ * @note      single consumer, only called by the worker
+ */
+static service_request_t *a_service_pop(service_t *service)
+{
+    service_request_t *tail;
+    service_request_t *next;
+    
+    /* skip the stub */
+    tail = service->tail;
+    next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    if (tail == &service->stub)
+    {
+        if (next == NULL)
+        {
+            return NULL;
+        }
+        service->tail = next;
+        tail = next;
+        next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    }
+    
+    /* the tail has a successor */
+    if (next != NULL)
+    {
+        service->tail = next;
+        
+        return tail;
+    }
+    
+    /* a producer is between the exchange and the link */
+    if (tail != __atomic_load_n(&service->head, __ATOMIC_ACQUIRE))
+    {
+        return NULL;
+    }
+    
+    /* the tail is the last one, push the stub behind it */
+    a_service_push(service, &service->stub);
+    next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    if (next != NULL)
+    {
+        service->tail = next;
+        
+        return tail;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     service run one request
+ * @param[in] *service pointer to a service structure
+ * @param[in] *request pointer to a service request structure
+ * @note      none
+ */
+static void a_service_run(service_t *service, service_request_t *request)
+{
+    uint32_t temperature_raw;
+    uint32_t pressure_raw;
+    uint32_t humidity_raw;
+    uint16_t adc_raw;
+    uint8_t adc_range;
+    
+    /* run the request */
+    if (request->type == SERVICE_REQUEST_TYPE_READ_TPH)
+    {
+        request->status = bme680_read_temperature_pressure_humidity(request->handle,
+                                                                    (uint32_t *)&temperature_raw, &request->temperature_c,
+                                                                    (uint32_t *)&pressure_raw, &request->pressure_pa,
+                                                                    (uint32_t *)&humidity_raw, &request->humidity_percentage);
+    }
+    else if (request->type == SERVICE_REQUEST_TYPE_READ)
+    {
+        request->status = bme680_read(request->handle,
+                                      (uint32_t *)&temperature_raw, &request->temperature_c,
+                                      (uint32_t *)&pressure_raw, &request->pressure_pa,
+                                      (uint32_t *)&humidity_raw, &request->humidity_percentage,
+                                      (uint16_t *)&adc_raw, (uint8_t *)&adc_range, &request->ohms, &request->index);
+    }
+    else if ((request->type == SERVICE_REQUEST_TYPE_CUSTOM) && (request->op != NULL))
+    {
+        request->status = request->op(request->handle, request->arg);
+    }
+    else
+    {
+        request->status = 1;
+    }
+    
+    /* update the statistics */
+    if (request->status != 0)
+    {
+        (void)__atomic_fetch_add(&service->failed, 1, __ATOMIC_RELAXED);
+    }
+    (void)__atomic_fetch_add(&service->completed, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief     service copy the result of an in-flight conversion
+ * @param[in] *leader pointer to the service request which ran the conversion
+ * @param[in] *request pointer to a queued service request structure
+ * @return    status code
+ *            - 0 request is not coalesced
+ *            - 1 request is coalesced
+ * @note      a read of all the channels serves both the read types,
+ *            a temperature pressure and humidity read only serves the same type
+ */
+static uint8_t a_service_coalesce(service_request_t *leader, service_request_t *request)
+{
+    /* only the same chip shares a sample */
+    if (leader->handle != request->handle)
+    {
+        return 0;
+    }
+    
+    /* check the types */
+    if ((leader->type != SERVICE_REQUEST_TYPE_READ_TPH) && (leader->type != SERVICE_REQUEST_TYPE_READ))
+    {
+        return 0;
+    }
+    if ((request->type != SERVICE_REQUEST_TYPE_READ_TPH) && (request->type != SERVICE_REQUEST_TYPE_READ))
+    {
+        return 0;
+    }
+    if ((request->type == SERVICE_REQUEST_TYPE_READ) && (leader->type != SERVICE_REQUEST_TYPE_READ))
+    {
+        return 0;
+    }
+    
+    /* share the sample */
+    request->status = leader->status;
+    request->temperature_c = leader->temperature_c;
+    request->pressure_pa = leader->pressure_pa;
+    request->humidity_percentage = leader->humidity_percentage;
+    request->ohms = leader->ohms;
+    request->index = leader->index;
+    
+    return 1;
+}
+
+/**
+ * @brief     service complete one request
+ * @param[in] *request pointer to a service request structure
+ * @note      the request can be released by the waiter after the post
+ */
+static void a_service_complete(service_request_t *request)
+{
+    /* run the callback */
+    if (request->callback != NULL)
+    {
+        request->callback(request);
+    }
+    
+    /* resolve the future */
+    (void)sem_post(&request->done);
+}
+
+/**
+ * @brief     service worker thread
+ * @param[in] *arg pointer to a service structure
+ * @return    NULL
+ * @note      it owns the bus, every driver call of the handles on the bus runs here
+ */
+static void *a_service_worker(void *arg)
+{
+    service_t *service = (service_t *)arg;
+    service_request_t *request;
+    service_request_t *next;
+    
+    while (1)
+    {
+        /* run the request left by the last coalescing first */
+        request = service->pending;
+        service->pending = NULL;
+        if (request == NULL)
+        {
+            /* sleep until one request is submitted */
+            while (sem_wait(&service->wake) != 0)
+            {
+                if (errno != EINTR)
+                {
+                    return NULL;
+                }
+            }
+            
+            /* get the request, retry while a producer is linking it */
+            while ((request = a_service_pop(service)) == NULL)
+            {
+                if (__atomic_load_n(&service->head, __ATOMIC_ACQUIRE) == service->tail)
+                {
+                    break;
+                }
+                (void)sched_yield();
+            }
+            
+            /* the queue is empty, the wake up belongs to a coalesced request or the stop */
+            if (request == NULL)
+            {
+                if (__atomic_load_n(&service->stop, __ATOMIC_ACQUIRE) != 0)
+                {
+                    return NULL;
+                }
+                
+                continue;
+            }
+        }
+        
+        /* run the request */
+        a_service_run(service, request);
+        
+        /* the reads queued during the conversion attach to it, stop at the first other request to keep the order */
+        while ((next = a_service_pop(service)) != NULL)
+        {
+            if (a_service_coalesce(request, next) == 0)
+            {
+                service->pending = next;
+                
+                break;
+            }
+            if (next->status != 0)
+            {
+                (void)__atomic_fetch_add(&service->failed, 1, __ATOMIC_RELAXED);
+            }
+            (void)__atomic_fetch_add(&service->completed, 1, __ATOMIC_RELAXED);
+            (void)__atomic_fetch_add(&service->coalesced, 1, __ATOMIC_RELAXED);
+            a_service_complete(next);
+        }
+        
+        /* complete the request */
+        a_service_complete(request);
+    }
+}
+
+/**
+ * @brief     service init and start the worker thread
+ * @param[in] *service pointer to a service structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      one service per bus, all the bme680 calls of the handles on the bus must be submitted to the service after this
+ */
+uint8_t service_init(service_t *service)
+{
+    /* init the queue */
+    service->stub.next = NULL;
+    service->head = &service->stub;
+    service->tail = &service->stub;
+    service->pending = NULL;
+    service->stop = 0;
+    service->submitters = 0;
+    service->completed = 0;
+    service->failed = 0;
+    service->coalesced = 0;
+    if (sem_init(&service->wake, 0, 0) != 0)
+    {
+        return 1;
+    }
+    
+    /* start the worker */
+    if (pthread_create(&service->thread, NULL, a_service_worker, service) != 0)
+    {
+        (void)sem_destroy(&service->wake);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     service stop the worker thread and deinit
+ * @param[in] *service pointer to a service structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      the submitted requests are completed before the worker exits and later submits are rejected
+ */
+uint8_t service_deinit(service_t *service)
+{
+    service_request_t *request;
+    
+    /* set stop and wait for the submits which passed the stop check */
+    __atomic_store_n(&service->stop, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&service->submitters, __ATOMIC_SEQ_CST) != 0)
+    {
+        (void)sched_yield();
+    }
+    
+    /* wake up the worker */
+    if (sem_post(&service->wake) != 0)
+    {
+        return 1;
+    }
+    
+    /* wait for the worker */
+    if (pthread_join(service->thread, NULL) != 0)
+    {
+        return 1;
+    }
+    
+    /* fail the requests left by a worker which exited on an error */
+    request = service->pending;
+    service->pending = NULL;
+    while ((request != NULL) || ((request = a_service_pop(service)) != NULL))
+    {
+        request->status = 1;
+        (void)__atomic_fetch_add(&service->failed, 1, __ATOMIC_RELAXED);
+        (void)__atomic_fetch_add(&service->completed, 1, __ATOMIC_RELAXED);
+        a_service_complete(request);
+        request = NULL;
+    }
+    (void)sem_destroy(&service->wake);
+    
+    return 0;
+}
+
+/**
+ * @brief     service request init
+ * @param[in] *request pointer to a service request structure
+ * @param[in] *handle pointer to an initialized bme680 handle structure on the service bus
+ * @param[in] type request type
+ * @param[in] *op pointer to a custom operation and it is only used by the custom type
+ * @param[in] *arg pointer to the custom operation arg
+ * @param[in] *callback pointer to a completion callback and NULL means none
+ * @param[in] *user pointer to the user data
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the callback runs in the worker thread and must not block
+ */
+uint8_t service_request_init(service_request_t *request, bme680_handle_t *handle, service_request_type_t type,
+                             uint8_t (*op)(bme680_handle_t *handle, void *arg), void *arg,
+                             void (*callback)(service_request_t *request), void *user)
+{
+    /* check the handle */
+    if ((handle == NULL) || (handle->inited != 1))
+    {
+        return 1;
+    }
+    
+    /* clear the request */
+    memset(request, 0, sizeof(service_request_t));
+    request->handle = handle;
+    request->type = type;
+    request->op = op;
+    request->arg = arg;
+    request->callback = callback;
+    request->user = user;
+    
+    /* init the future */
+    if (sem_init(&request->done, 0, 0) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     service request deinit
+ * @param[in] *request pointer to a service request structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+uint8_t service_request_deinit(service_request_t *request)
+{
+    if (sem_destroy(&request->done) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     service submit a request
+ * @param[in] *service pointer to a service structure
+ * @param[in] *request pointer to a service request structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ * @note      it never blocks and it can be called from any thread,
+ *            the request must stay valid until it is completed,
+ *            read requests of the same handle queued behind a running read attach to it and get the same sample
+ */
+uint8_t service_submit(service_t *service, service_request_t *request)
+{
+    uint8_t res;
+    
+    /* check the stop, the deinit waits for the submits which passed it */
+    (void)__atomic_fetch_add(&service->submitters, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&service->stop, __ATOMIC_SEQ_CST) != 0)
+    {
+        (void)__atomic_fetch_sub(&service->submitters, 1, __ATOMIC_SEQ_CST);
+        
+        return 1;
+    }
+    
+    /* push and wake up the worker */
+    a_service_push(service, request);
+    res = (sem_post(&service->wake) != 0) ? 1 : 0;
+    (void)__atomic_fetch_sub(&service->submitters, 1, __ATOMIC_SEQ_CST);
+    
+    return res;
+}
+
+/**
+ * @brief     service wait for a request completion
+ * @param[in] *request pointer to a service request structure
+ * @param[in] timeout_ms timeout in ms and 0 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed
+ *            - 2 timeout
+ * @note      the request result is valid after this returns 0, check request->status for the driver result
+ */
+uint8_t service_wait(service_request_t *request, uint32_t timeout_ms)
+{
+    int res;
+    struct timespec ts;
+    
+    /* wait forever */
+    if (timeout_ms == 0)
+    {
+        while ((res = sem_wait(&request->done)) != 0)
+        {
+            if (errno != EINTR)
+            {
+                return 1;
+            }
+        }
+        
+        return 0;
+    }
+    
+    /* set the absolute timeout */
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    
+    /* wait with the timeout */
+    while ((res = sem_timedwait(&request->done, &ts)) != 0)
+    {
+        if (errno == ETIMEDOUT)
+        {
+            return 2;
+        }
+        else if (errno != EINTR)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      service get the statistics
+ * @param[in]  *service pointer to a service structure
+ * @param[out] *completed pointer to a completed request counter buffer
+ * @param[out] *failed pointer to a failed request counter buffer
+ * @param[out] *coalesced pointer to a coalesced request counter buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the coalesced requests are included in the completed requests
+ */
+uint8_t service_get_statistics(service_t *service, uint32_t *completed, uint32_t *failed, uint32_t *coalesced)
+{
+    *completed = __atomic_load_n(&service->completed, __ATOMIC_RELAXED);
+    *failed = __atomic_load_n(&service->failed, __ATOMIC_RELAXED);
+    *coalesced = __atomic_load_n(&service->coalesced, __ATOMIC_RELAXED);
+    
+    return 0;
+}
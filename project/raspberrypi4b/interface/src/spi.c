@@ -39,6 +39,8 @@
 #include <sys/ioctl.h>
 #include <fcntl.h>
 
+static int gs_3_wire_fd = -1;        /**< spi handle in the 3 wire mode */
+
 /**
  * @brief      spi bus init
  * @param[in]  *name pointer to a spi device name buffer
@@ -132,6 +134,12 @@ uint8_t spi_init(char *name, int *fd, spi_mode_type_t mode, uint32_t freq)
             return 1;
         }
         
+        /* a new handle starts in the 4 wire mode */
+        if (gs_3_wire_fd == *fd)
+        {
+            gs_3_wire_fd = -1;
+        }
+        
         return 0;
     }
 }
@@ -146,6 +154,12 @@ uint8_t spi_init(char *name, int *fd, spi_mode_type_t mode, uint32_t freq)
  */
 uint8_t spi_deinit(int fd)
 {
+    /* forget the 3 wire mode */
+    if (gs_3_wire_fd == fd)
+    {
+        gs_3_wire_fd = -1;
+    }
+    
     /* close the spi */
     if (close(fd) < 0)
     {
@@ -159,6 +173,59 @@ uint8_t spi_deinit(int fd)
     }
 }
 
+/**
+ * @brief     spi bus enable or disable the 3 wire mode
+ * @param[in] fd spi handle
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set 3 wire failed
+ * @note      in the 3 wire mode mosi is used as the bidirectional data line,
+ *            the mode is cached here so spi_read doesn't query it for every transfer
+ */
+uint8_t spi_set_3_wire(int fd, uint8_t enable)
+{
+    uint8_t mode;
+    
+    /* get the spi mode */
+    if (ioctl(fd, SPI_IOC_RD_MODE, &mode) < 0)
+    {
+        perror("spi: read mode get failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the 3 wire bit */
+    if (enable != 0)
+    {
+        mode |= SPI_3WIRE;
+    }
+    else
+    {
+        mode &= ~SPI_3WIRE;
+    }
+    
+    /* set the spi mode */
+    if (ioctl(fd, SPI_IOC_WR_MODE, &mode) < 0)
+    {
+        perror("spi: write mode set failed.\n");
+        
+        return 1;
+    }
+    
+    /* cache the 3 wire mode */
+    if (enable != 0)
+    {
+        gs_3_wire_fd = fd;
+    }
+    else if (gs_3_wire_fd == fd)
+    {
+        gs_3_wire_fd = -1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief      spi bus read command
  * @param[in]  fd spi handle
@@ -203,15 +270,42 @@ uint8_t spi_read_cmd(int fd, uint8_t *buf, uint16_t len)
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       in the 3 wire mode set by spi_set_3_wire the address and the data are sent as two transfers
  */
 uint8_t spi_read(int fd, uint8_t reg, uint8_t *buf, uint16_t len)
 {
     struct spi_ioc_transfer k;
+    struct spi_ioc_transfer t[2];
     uint8_t command[len + 1];
     uint8_t recv[len + 1];
     int l;
     
+    /* the 3 wire mode can't transmit and receive in one transfer */
+    if (gs_3_wire_fd == fd)
+    {
+        /* clear ioc transfer */
+        memset(t, 0, sizeof(struct spi_ioc_transfer) * 2);
+        
+        /* set the param */
+        t[0].tx_buf = (unsigned long)&reg;
+        t[0].len = 1;
+        t[0].cs_change = 0;
+        t[1].rx_buf = (unsigned long)buf;
+        t[1].len = len;
+        t[1].cs_change = 0;
+        
+        /* transmit */
+        l = ioctl(fd, SPI_IOC_MESSAGE(2), t);
+        if (l != (len + 1))
+        {
+            perror("spi: length check error.\n");
+            
+            return 1;
+        }
+        
+        return 0;
+    }
+    
     /* set the command */
     command[0] = reg;
     memset(&command[1], 0x00, len);
@@ -37,9 +37,1520 @@
 #include "driver_bme680_read_test.h"
 #include "driver_bme680_register_test.h"
 #include "driver_bme680_basic.h"
+#include "driver_bme680_edf.h"
 #include "driver_bme680_gas.h"
+#include "driver_bme680_multirate.h"
+#include "driver_bme680_sampler.h"
+#include "driver_bme680_tuner.h"
+#include "driver_bme680_sync.h"
+#include "driver_bme680_discovery.h"
+#include "scheduler.h"
+#include "gpio.h"
+#include "service.h"
 #include <getopt.h>
 #include <stdlib.h>
+#include <signal.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+
+/**
+ * @brief stream output format enumeration definition
+ */
+typedef enum
+{
+    STREAM_FORMAT_CSV    = 0x00,        /**< csv */
+    STREAM_FORMAT_JSON   = 0x01,        /**< json lines */
+    STREAM_FORMAT_BINARY = 0x02,        /**< binary frame */
+} stream_format_t;
+
+/**
+ * @brief stream buffer size definition
+ */
+#define STREAM_BUFFER_SIZE        (64 * 1024)        /**< 64KB stream buffer */
+
+static volatile sig_atomic_t gs_stop = 0;            /**< stop flag */
+static char gs_stream_buffer[STREAM_BUFFER_SIZE];    /**< stream buffer */
+static FILE *gs_stream_file = NULL;                  /**< stream file on the original stdout */
+static int gs_stream_stdout_fd = -1;                 /**< saved stdout descriptor */
+
+/**
+ * @brief     stream signal handler
+ * @param[in] signum signal number
+ * @note      none
+ */
+static void a_stream_signal_handler(int signum)
+{
+    (void)signum;
+    
+    /* set stop */
+    gs_stop = 1;
+}
+
+/**
+ * @brief bench counter structure definition
+ */
+typedef struct bench_counter_s
+{
+    uint32_t transactions;        /**< bus transaction counter */
+    uint64_t bus_ns;              /**< bus time in ns */
+    uint64_t wait_ns;             /**< delay time in ns */
+} bench_counter_t;
+
+/**
+ * @brief bench api structure definition
+ */
+typedef struct bench_api_s
+{
+    const char *name;                                  /**< api name */
+    bme680_bool_t run_gas;                             /**< run gas */
+    uint8_t (*read)(bme680_handle_t *handle);          /**< read function */
+} bench_api_t;
+
+static bme680_handle_t gs_bench_handle;            /**< bench handle */
+static bench_counter_t gs_bench_counter;           /**< bench counter */
+static uint32_t gs_bench_duration_us;              /**< bench conversion duration */
+
+/**
+ * @brief     bench account one bus transaction
+ * @param[in] start_ns start time in ns
+ * @note      none
+ */
+static void a_bench_account(uint64_t start_ns)
+{
+    gs_bench_counter.transactions++;
+    gs_bench_counter.bus_ns += scheduler_get_time_ns() - start_ns;
+}
+
+/**
+ * @brief     bench iic read
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      none
+ */
+static uint8_t a_bench_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint64_t start_ns;
+    
+    start_ns = scheduler_get_time_ns();
+    res = bme680_interface_iic_read(addr, reg, buf, len);
+    a_bench_account(start_ns);
+    
+    return res;
+}
+
+/**
+ * @brief     bench iic write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bench_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint64_t start_ns;
+    
+    start_ns = scheduler_get_time_ns();
+    res = bme680_interface_iic_write(addr, reg, buf, len);
+    a_bench_account(start_ns);
+    
+    return res;
+}
+
+/**
+ * @brief      bench spi read
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_bench_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint64_t start_ns;
+    
+    start_ns = scheduler_get_time_ns();
+    res = bme680_interface_spi_read(reg, buf, len);
+    a_bench_account(start_ns);
+    
+    return res;
+}
+
+/**
+ * @brief     bench spi write
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_bench_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    uint64_t start_ns;
+    
+    start_ns = scheduler_get_time_ns();
+    res = bme680_interface_spi_write(reg, buf, len);
+    a_bench_account(start_ns);
+    
+    return res;
+}
+
+/**
+ * @brief     bench delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_bench_delay_ms(uint32_t ms)
+{
+    uint64_t start_ns;
+    
+    start_ns = scheduler_get_time_ns();
+    bme680_interface_delay_ms(ms);
+    gs_bench_counter.wait_ns += scheduler_get_time_ns() - start_ns;
+}
+
+/**
+ * @brief     bench read the temperature pressure and humidity
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_bench_read_temperature_pressure_humidity(bme680_handle_t *handle)
+{
+    uint32_t temperature_raw;
+    uint32_t pressure_raw;
+    uint32_t humidity_raw;
+    float temperature_c;
+    float pressure_pa;
+    float humidity_percentage;
+    
+    return bme680_read_temperature_pressure_humidity(handle, &temperature_raw, &temperature_c,
+                                                     &pressure_raw, &pressure_pa,
+                                                     &humidity_raw, &humidity_percentage);
+}
+
+/**
+ * @brief     bench read the temperature
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_bench_read_temperature(bme680_handle_t *handle)
+{
+    uint32_t temperature_raw;
+    float temperature_c;
+    
+    return bme680_read_temperature(handle, &temperature_raw, &temperature_c);
+}
+
+/**
+ * @brief     bench read the pressure
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_bench_read_pressure(bme680_handle_t *handle)
+{
+    uint32_t pressure_raw;
+    float pressure_pa;
+    
+    return bme680_read_pressure(handle, &pressure_raw, &pressure_pa);
+}
+
+/**
+ * @brief     bench read the humidity
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_bench_read_humidity(bme680_handle_t *handle)
+{
+    uint32_t humidity_raw;
+    float humidity_percentage;
+    
+    return bme680_read_humidity(handle, &humidity_raw, &humidity_percentage);
+}
+
+/**
+ * @brief     bench read the gas resistance
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_bench_read_gas_resistance(bme680_handle_t *handle)
+{
+    uint16_t adc_raw;
+    uint8_t adc_range;
+    uint8_t index;
+    float ohms;
+    
+    return bme680_read_gas_resistance(handle, &adc_raw, &adc_range, &ohms, &index);
+}
+
+/**
+ * @brief     bench read all
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_bench_read(bme680_handle_t *handle)
+{
+    uint32_t temperature_raw;
+    uint32_t pressure_raw;
+    uint32_t humidity_raw;
+    float temperature_c;
+    float pressure_pa;
+    float humidity_percentage;
+    uint16_t adc_raw;
+    uint8_t adc_range;
+    uint8_t index;
+    float ohms;
+    
+    return bme680_read(handle, &temperature_raw, &temperature_c,
+                       &pressure_raw, &pressure_pa,
+                       &humidity_raw, &humidity_percentage,
+                       &adc_raw, &adc_range, &ohms, &index);
+}
+
+/**
+ * @brief     bench trigger, sleep for the conversion time and get the result
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_bench_get_temperature_pressure_humidity(bme680_handle_t *handle)
+{
+    uint8_t res;
+    uint32_t temperature_raw;
+    uint32_t pressure_raw;
+    uint32_t humidity_raw;
+    float temperature_c;
+    float pressure_pa;
+    float humidity_percentage;
+    uint64_t start_ns;
+    struct timespec ts;
+    
+    res = bme680_set_mode(handle, BME680_MODE_FORCED);
+    if (res != 0)
+    {
+        return res;
+    }
+    ts.tv_sec = gs_bench_duration_us / 1000000;
+    ts.tv_nsec = (long)(gs_bench_duration_us % 1000000) * 1000;
+    start_ns = scheduler_get_time_ns();
+    (void)nanosleep(&ts, NULL);
+    gs_bench_counter.wait_ns += scheduler_get_time_ns() - start_ns;
+    
+    return bme680_get_temperature_pressure_humidity(handle, &temperature_raw, &temperature_c,
+                                                    &pressure_raw, &pressure_pa,
+                                                    &humidity_raw, &humidity_percentage);
+}
+
+/**
+ * @brief     bench compare two latencies
+ * @param[in] *a pointer to the first latency
+ * @param[in] *b pointer to the second latency
+ * @return    compare result
+ * @note      none
+ */
+static int a_bench_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief     bench init the handle
+ * @param[in] interface chip interface
+ * @param[in] addr chip address pin
+ * @param[in] degree_celsius heater degree celsius
+ * @param[in] gas_wait_ms heater wait time in ms
+ * @param[in] index heater index
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_bench_init(bme680_interface_t interface, bme680_address_t addr,
+                            float degree_celsius, uint16_t gas_wait_ms, uint8_t index)
+{
+    uint8_t reg;
+    
+    /* link interface function */
+    DRIVER_BME680_LINK_INIT(&gs_bench_handle, bme680_handle_t); 
+    DRIVER_BME680_LINK_IIC_INIT(&gs_bench_handle, bme680_interface_iic_init);
+    DRIVER_BME680_LINK_IIC_DEINIT(&gs_bench_handle, bme680_interface_iic_deinit);
+    DRIVER_BME680_LINK_IIC_READ(&gs_bench_handle, a_bench_iic_read);
+    DRIVER_BME680_LINK_IIC_WRITE(&gs_bench_handle, a_bench_iic_write);
+    DRIVER_BME680_LINK_SPI_INIT(&gs_bench_handle, bme680_interface_spi_init);
+    DRIVER_BME680_LINK_SPI_DEINIT(&gs_bench_handle, bme680_interface_spi_deinit);
+    DRIVER_BME680_LINK_SPI_READ(&gs_bench_handle, a_bench_spi_read);
+    DRIVER_BME680_LINK_SPI_WRITE(&gs_bench_handle, a_bench_spi_write);
+    DRIVER_BME680_LINK_DELAY_MS(&gs_bench_handle, a_bench_delay_ms);
+    DRIVER_BME680_LINK_DEBUG_PRINT(&gs_bench_handle, bme680_interface_debug_print);
+    DRIVER_BME680_LINK_BUS_LOCK(&gs_bench_handle, bme680_interface_bus_lock);
+    DRIVER_BME680_LINK_BUS_UNLOCK(&gs_bench_handle, bme680_interface_bus_unlock);
+    DRIVER_BME680_LINK_GET_TIME_MS(&gs_bench_handle, bme680_interface_get_time_ms);
+    
+    /* init the chip */
+    if (bme680_set_interface(&gs_bench_handle, interface) != 0)
+    {
+        return 1;
+    }
+    if (bme680_set_addr_pin(&gs_bench_handle, addr) != 0)
+    {
+        return 1;
+    }
+    if (bme680_init(&gs_bench_handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* set the basic example configuration */
+    if ((bme680_set_temperature_oversampling(&gs_bench_handle, BME680_BASIC_DEFAULT_TEMPERATURE_OVERSAMPLING) != 0) ||
+        (bme680_set_pressure_oversampling(&gs_bench_handle, BME680_BASIC_DEFAULT_PRESSURE_OVERSAMPLING) != 0) ||
+        (bme680_set_humidity_oversampling(&gs_bench_handle, BME680_BASIC_DEFAULT_HUMIDITY_OVERSAMPLING) != 0) ||
+        (bme680_set_filter(&gs_bench_handle, BME680_BASIC_DEFAULT_FILTER) != 0) ||
+        (bme680_set_spi_wire(&gs_bench_handle, BME680_BASIC_DEFAULT_SPI_WIRE) != 0))
+    {
+        (void)bme680_deinit(&gs_bench_handle);
+        
+        return 1;
+    }
+    
+    /* set the heater profile */
+    if ((bme680_resistance_heater_convert_to_register(&gs_bench_handle, degree_celsius, &reg) != 0) ||
+        (bme680_set_resistance_heater(&gs_bench_handle, index, reg) != 0) ||
+        (bme680_gas_wait_convert_to_register(&gs_bench_handle, gas_wait_ms, &reg) != 0) ||
+        (bme680_set_gas_wait(&gs_bench_handle, index, reg) != 0) ||
+        (bme680_set_convert_index(&gs_bench_handle, index) != 0) ||
+        (bme680_set_mode(&gs_bench_handle, BME680_MODE_SLEEP) != 0))
+    {
+        (void)bme680_deinit(&gs_bench_handle);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the read benchmark
+ * @param[in] addr chip address pin
+ * @param[in] degree_celsius heater degree celsius
+ * @param[in] gas_wait_ms heater wait time in ms
+ * @param[in] index heater index
+ * @param[in] times read times of each api
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      both iic and spi are measured and an unavailable interface is skipped
+ */
+static uint8_t a_bench(bme680_address_t addr, float degree_celsius, uint16_t gas_wait_ms, uint8_t index, uint32_t times)
+{
+    const bench_api_t api[] =
+    {
+        {"read_temperature_pressure_humidity", BME680_BOOL_FALSE, a_bench_read_temperature_pressure_humidity},
+        {"read_temperature", BME680_BOOL_FALSE, a_bench_read_temperature},
+        {"read_pressure", BME680_BOOL_FALSE, a_bench_read_pressure},
+        {"read_humidity", BME680_BOOL_FALSE, a_bench_read_humidity},
+        {"get_temperature_pressure_humidity", BME680_BOOL_FALSE, a_bench_get_temperature_pressure_humidity},
+        {"read_gas_resistance", BME680_BOOL_TRUE, a_bench_read_gas_resistance},
+        {"read", BME680_BOOL_TRUE, a_bench_read},
+    };
+    const bme680_interface_t interface[2] = {BME680_INTERFACE_IIC, BME680_INTERFACE_SPI};
+    const char *interface_name[2] = {"iic", "spi"};
+    uint8_t ok = 0;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    uint32_t failed;
+    uint64_t *latency;
+    uint64_t start_ns;
+    uint64_t total_ns;
+    uint64_t sum_ns;
+    
+    /* check the times */
+    if (times == 0)
+    {
+        return 1;
+    }
+    latency = (uint64_t *)malloc(sizeof(uint64_t) * times);
+    if (latency == NULL)
+    {
+        return 1;
+    }
+    
+    bme680_interface_debug_print("bme680: %u reads per api, latency in us.\n", times);
+    bme680_interface_debug_print("%-4s %-34s %10s %10s %10s %10s %10s %10s %8s %8s %8s %6s\n",
+                                 "bus", "api", "min", "mean", "p50", "p99", "max", "samples/s",
+                                 "xfer/rd", "bus/rd", "wait/rd", "fail");
+    for (k = 0; k < 2; k++)
+    {
+        /* init */
+        if (a_bench_init(interface[k], addr, degree_celsius, gas_wait_ms, index) != 0)
+        {
+            bme680_interface_debug_print("%-4s skipped, init failed.\n", interface_name[k]);
+            
+            continue;
+        }
+        ok = 1;
+        
+        for (j = 0; j < sizeof(api) / sizeof(api[0]); j++)
+        {
+            /* set the gas configuration */
+            if ((bme680_set_heater_off(&gs_bench_handle, (api[j].run_gas == BME680_BOOL_TRUE) ? BME680_BOOL_FALSE : BME680_BOOL_TRUE) != 0) ||
+                (bme680_set_run_gas(&gs_bench_handle, api[j].run_gas) != 0) ||
+                (bme680_get_measurement_duration(&gs_bench_handle, &gs_bench_duration_us) != 0))
+            {
+                bme680_interface_debug_print("%-4s %-34s skipped, config failed.\n", interface_name[k], api[j].name);
+                
+                continue;
+            }
+            
+            /* run */
+            memset(&gs_bench_counter, 0, sizeof(bench_counter_t));
+            failed = 0;
+            sum_ns = 0;
+            total_ns = scheduler_get_time_ns();
+            for (i = 0; i < times; i++)
+            {
+                start_ns = scheduler_get_time_ns();
+                if (api[j].read(&gs_bench_handle) != 0)
+                {
+                    failed++;
+                }
+                latency[i] = scheduler_get_time_ns() - start_ns;
+                sum_ns += latency[i];
+            }
+            total_ns = scheduler_get_time_ns() - total_ns;
+            
+            /* output */
+            qsort(latency, times, sizeof(uint64_t), a_bench_compare);
+            bme680_interface_debug_print("%-4s %-34s %10.1f %10.1f %10.1f %10.1f %10.1f %10.2f %8.1f %8.1f %8.1f %6u\n",
+                                         interface_name[k], api[j].name,
+                                         (double)latency[0] / 1000.0,
+                                         (double)sum_ns / times / 1000.0,
+                                         (double)latency[(times - 1) / 2] / 1000.0,
+                                         (double)latency[(uint32_t)ceil(times * 0.99) - 1] / 1000.0,
+                                         (double)latency[times - 1] / 1000.0,
+                                         (double)times * 1000000000.0 / (double)total_ns,
+                                         (double)gs_bench_counter.transactions / times,
+                                         (double)gs_bench_counter.bus_ns / times / 1000.0,
+                                         (double)gs_bench_counter.wait_ns / times / 1000.0,
+                                         failed);
+        }
+        
+        /* deinit */
+        (void)bme680_set_heater_off(&gs_bench_handle, BME680_BOOL_TRUE);
+        (void)bme680_deinit(&gs_bench_handle);
+    }
+    free(latency);
+    
+    return (ok != 0) ? 0 : 1;
+}
+
+/**
+ * @brief service client structure definition
+ */
+typedef struct service_client_s
+{
+    service_t *service;            /**< shared service */
+    bme680_handle_t *handle;       /**< target bme680 handle */
+    pthread_t thread;              /**< client thread */
+    uint32_t times;                /**< request times */
+    uint32_t done;                 /**< completed request counter */
+    uint32_t failed;               /**< failed request counter */
+    uint64_t submit_ns_max;        /**< max submit time in ns */
+    uint64_t latency_ns_sum;       /**< sum of the completion latency in ns */
+    uint64_t latency_ns_max;       /**< max completion latency in ns */
+    float temperature_c;           /**< last temperature */
+} service_client_t;
+
+/**
+ * @brief     service client thread
+ * @param[in] *arg pointer to a service client structure
+ * @return    NULL
+ * @note      none
+ */
+static void *a_service_client(void *arg)
+{
+    service_client_t *client = (service_client_t *)arg;
+    service_request_t request;
+    uint64_t start_ns;
+    uint64_t submit_ns;
+    uint64_t latency_ns;
+    uint32_t i;
+    
+    for (i = 0; i < client->times; i++)
+    {
+        /* submit one read */
+        if (service_request_init(&request, client->handle, SERVICE_REQUEST_TYPE_READ_TPH, NULL, NULL, NULL, NULL) != 0)
+        {
+            client->failed++;
+            
+            continue;
+        }
+        start_ns = scheduler_get_time_ns();
+        if (service_submit(client->service, &request) != 0)
+        {
+            (void)service_request_deinit(&request);
+            client->failed++;
+            
+            continue;
+        }
+        submit_ns = scheduler_get_time_ns() - start_ns;
+        
+        /* wait for the future */
+        if ((service_wait(&request, 0) != 0) || (request.status != 0))
+        {
+            client->failed++;
+        }
+        else
+        {
+            client->temperature_c = request.temperature_c;
+        }
+        latency_ns = scheduler_get_time_ns() - start_ns;
+        (void)service_request_deinit(&request);
+        
+        /* update the statistics */
+        client->done++;
+        client->latency_ns_sum += latency_ns;
+        if (latency_ns > client->latency_ns_max)
+        {
+            client->latency_ns_max = latency_ns;
+        }
+        if (submit_ns > client->submit_ns_max)
+        {
+            client->submit_ns_max = submit_ns;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     run the service with concurrent clients
+ * @param[in] interface chip interface
+ * @param[in] addr chip address pin
+ * @param[in] threads client thread number
+ * @param[in] times read times of each client
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      all the clients share one worker thread which owns the bus
+ */
+static uint8_t a_service(bme680_interface_t interface, bme680_address_t addr, uint32_t threads, uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t completed;
+    uint32_t failed;
+    uint32_t coalesced;
+    uint32_t started;
+    uint64_t total_ns;
+    service_t service;
+    service_client_t *client;
+    
+    /* check the threads */
+    if (threads == 0)
+    {
+        return 1;
+    }
+    client = (service_client_t *)calloc(threads, sizeof(service_client_t));
+    if (client == NULL)
+    {
+        return 1;
+    }
+    
+    /* init the chip with the basic example configuration */
+    res = a_bench_init(interface, addr, 200.0f, 150, 0);
+    if (res != 0)
+    {
+        free(client);
+        
+        return 1;
+    }
+    if ((bme680_set_heater_off(&gs_bench_handle, BME680_BOOL_TRUE) != 0) ||
+        (bme680_set_run_gas(&gs_bench_handle, BME680_BOOL_FALSE) != 0))
+    {
+        (void)bme680_deinit(&gs_bench_handle);
+        free(client);
+        
+        return 1;
+    }
+    
+    /* service init */
+    res = service_init(&service);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: service init failed.\n");
+        (void)bme680_deinit(&gs_bench_handle);
+        free(client);
+        
+        return 1;
+    }
+    
+    /* start the clients */
+    total_ns = scheduler_get_time_ns();
+    for (started = 0; started < threads; started++)
+    {
+        client[started].service = &service;
+        client[started].handle = &gs_bench_handle;
+        client[started].times = times;
+        if (pthread_create(&client[started].thread, NULL, a_service_client, &client[started]) != 0)
+        {
+            bme680_interface_debug_print("bme680: create client thread failed.\n");
+            
+            break;
+        }
+    }
+    for (i = 0; i < started; i++)
+    {
+        (void)pthread_join(client[i].thread, NULL);
+    }
+    total_ns = scheduler_get_time_ns() - total_ns;
+    
+    /* output */
+    for (i = 0; i < started; i++)
+    {
+        bme680_interface_debug_print("bme680: client %u done %u, failed %u, max submit %0.1fus, mean latency %0.1fus, max latency %0.1fus, temperature %0.2fC.\n",
+                                     i, client[i].done, client[i].failed,
+                                     (double)client[i].submit_ns_max / 1000.0,
+                                     (client[i].done != 0) ? ((double)client[i].latency_ns_sum / client[i].done / 1000.0) : 0.0,
+                                     (double)client[i].latency_ns_max / 1000.0,
+                                     client[i].temperature_c);
+    }
+    
+    /* service deinit */
+    (void)service_deinit(&service);
+    (void)service_get_statistics(&service, (uint32_t *)&completed, (uint32_t *)&failed, (uint32_t *)&coalesced);
+    bme680_interface_debug_print("bme680: service completed %u requests with %u conversions in %0.3fs, coalesced %u, failed %u.\n",
+                                 completed, completed - coalesced, (double)total_ns / 1000000000.0, coalesced, failed);
+    
+    /* deinit */
+    (void)bme680_deinit(&gs_bench_handle);
+    free(client);
+    
+    return (started == threads) ? 0 : 1;
+}
+
+/**
+ * @brief  stream open the output
+ * @return status code
+ *         - 0 success
+ *         - 1 open failed
+ * @note   the frames go to a dedicated buffered file on the original stdout and
+ *         stdout is pointed at stderr, so the driver diagnostics don't mix into the stream
+ */
+static uint8_t a_stream_output_init(void)
+{
+    int fd;
+    
+    /* flush the pending output */
+    (void)fflush(stdout);
+    
+    /* open the stream file on a copy of stdout and set its buffer before any output */
+    fd = dup(STDOUT_FILENO);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    gs_stream_file = fdopen(fd, "w");
+    if (gs_stream_file == NULL)
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    (void)setvbuf(gs_stream_file, gs_stream_buffer, _IOFBF, STREAM_BUFFER_SIZE);
+    
+    /* send the diagnostics to stderr */
+    gs_stream_stdout_fd = dup(STDOUT_FILENO);
+    if ((gs_stream_stdout_fd < 0) || (dup2(STDERR_FILENO, STDOUT_FILENO) < 0))
+    {
+        if (gs_stream_stdout_fd >= 0)
+        {
+            (void)close(gs_stream_stdout_fd);
+            gs_stream_stdout_fd = -1;
+        }
+        (void)fclose(gs_stream_file);
+        gs_stream_file = NULL;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief stream close the output
+ * @note  the stream file is flushed and stdout is restored
+ */
+static void a_stream_output_deinit(void)
+{
+    /* flush and close the stream file */
+    if (gs_stream_file != NULL)
+    {
+        (void)fclose(gs_stream_file);
+        gs_stream_file = NULL;
+    }
+    
+    /* restore stdout */
+    (void)fflush(stdout);
+    if (gs_stream_stdout_fd >= 0)
+    {
+        (void)dup2(gs_stream_stdout_fd, STDOUT_FILENO);
+        (void)close(gs_stream_stdout_fd);
+        gs_stream_stdout_fd = -1;
+    }
+}
+
+/**
+ * @brief     stream write one frame to stdout
+ * @param[in] format output format
+ * @param[in] *frame pointer to a frame buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_stream_write(stream_format_t format, bme680_sampler_frame_t *frame)
+{
+    int res;
+    
+    if (format == STREAM_FORMAT_BINARY)
+    {
+        uint8_t buf[BME680_SAMPLER_FRAME_LEN];
+        
+        /* pack the frame */
+        (void)bme680_sampler_pack(frame, buf);
+        res = (fwrite(buf, 1, BME680_SAMPLER_FRAME_LEN, gs_stream_file) == BME680_SAMPLER_FRAME_LEN) ? 0 : -1;
+    }
+    else if (format == STREAM_FORMAT_JSON)
+    {
+        res = fprintf(gs_stream_file, "{\"sequence\":%u,\"timestamp_us\":%llu,\"temperature_c\":%0.2f,"
+                      "\"pressure_pa\":%0.2f,\"humidity_percentage\":%0.2f}\n",
+                      frame->sequence, (unsigned long long)frame->timestamp_us, frame->temperature_c,
+                      frame->pressure_pa, frame->humidity_percentage);
+    }
+    else
+    {
+        res = fprintf(gs_stream_file, "%u,%llu,%0.2f,%0.2f,%0.2f\n",
+                      frame->sequence, (unsigned long long)frame->timestamp_us, frame->temperature_c,
+                      frame->pressure_pa, frame->humidity_percentage);
+    }
+    
+    return (res < 0) ? 1 : 0;
+}
+
+/**
+ * @brief  stream enable the data ready interrupt
+ * @return status code
+ *         - 0 success
+ *         - 1 enable failed
+ * @note   the chip and the host are switched to the spi 3 wire mode and the sdo pin is GPIO17(BCM)
+ */
+static uint8_t a_stream_interrupt_init(void)
+{
+    /* enable the chip interrupt, the chip is in the 3 wire mode after this */
+    if (bme680_sampler_set_data_interrupt(BME680_BOOL_TRUE) != 0)
+    {
+        bme680_interface_debug_print("bme680: set data interrupt failed.\n");
+        
+        return 1;
+    }
+    
+    /* follow the chip wire mode */
+    if (bme680_interface_spi_set_3_wire(1) != 0)
+    {
+        bme680_interface_debug_print("bme680: set spi 3 wire failed.\n");
+        
+        return 1;
+    }
+    
+    /* gpio interrupt init */
+    if (gpio_interrupt_init() != 0)
+    {
+        bme680_interface_debug_print("bme680: gpio interrupt init failed.\n");
+        (void)bme680_sampler_set_data_interrupt(BME680_BOOL_FALSE);
+        (void)bme680_interface_spi_set_3_wire(0);
+        
+        return 1;
+    }
+    (void)gpio_interrupt_clear();
+    
+    return 0;
+}
+
+/**
+ * @brief  stream disable the data ready interrupt
+ * @return status code
+ *         - 0 success
+ *         - 1 disable failed
+ * @note   the chip and the host are switched back to the spi 4 wire mode
+ */
+static uint8_t a_stream_interrupt_deinit(void)
+{
+    uint8_t res;
+    
+    /* gpio interrupt deinit */
+    res = gpio_interrupt_deinit();
+    
+    /* disable the chip interrupt and switch back */
+    if (bme680_sampler_set_data_interrupt(BME680_BOOL_FALSE) != 0)
+    {
+        res = 1;
+    }
+    if (bme680_interface_spi_set_3_wire(0) != 0)
+    {
+        res = 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     stream samples to stdout
+ * @param[in] interface chip interface
+ * @param[in] addr chip address pin
+ * @param[in] rate sample rate in hz and 0 means as fast as possible
+ * @param[in] format output format
+ * @param[in] times frame number and 0 means until interrupted
+ * @param[in] interrupt bool value and true means the read is triggered by the data ready interrupt
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      samples go to stdout, the report and the driver diagnostics go to stderr,
+ *            rate 0 without the interrupt runs the driver free running mode
+ */
+static uint8_t a_stream(bme680_interface_t interface, bme680_address_t addr,
+                        float rate, stream_format_t format, uint32_t times, bme680_bool_t interrupt)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t duration_us;
+    uint32_t overrun;
+    uint32_t dropped;
+    uint32_t failed;
+    uint64_t period_ns;
+    uint64_t start_ns;
+    uint64_t deadline_ns;
+    uint64_t edge_ns;
+    uint64_t trigger_ns;
+    uint64_t now_ns;
+    uint32_t timeout_ms;
+    uint32_t timeouts;
+    double seconds;
+    struct timespec ts;
+    struct timespec rest;
+    bme680_bool_t free_running;
+    scheduler_t sched;
+    scheduler_statistics_t statistics;
+    bme680_sampler_frame_t frame;
+    
+    /* output init */
+    if (a_stream_output_init() != 0)
+    {
+        (void)fprintf(stderr, "bme680: open stream output failed.\n");
+        
+        return 1;
+    }
+    
+    /* sampler init */
+    res = bme680_sampler_init(interface, addr, &duration_us);
+    if (res != 0)
+    {
+        a_stream_output_deinit();
+        
+        return 1;
+    }
+    
+    /* data ready interrupt init */
+    if ((interrupt == BME680_BOOL_TRUE) && (a_stream_interrupt_init() != 0))
+    {
+        (void)bme680_sampler_deinit();
+        a_stream_output_deinit();
+        
+        return 1;
+    }
+    
+    /* scheduler init */
+    period_ns = (rate > 0.0f) ? (uint64_t)(1000000000.0 / rate) : 0;
+    if ((period_ns != 0) && (scheduler_init(&sched, period_ns, SCHEDULER_ALIGN_SECOND) != 0))
+    {
+        if (interrupt == BME680_BOOL_TRUE)
+        {
+            (void)a_stream_interrupt_deinit();
+        }
+        (void)bme680_sampler_deinit();
+        a_stream_output_deinit();
+        
+        return 1;
+    }
+    
+    /* set the signal */
+    gs_stop = 0;
+    (void)signal(SIGINT, a_stream_signal_handler);
+    (void)signal(SIGTERM, a_stream_signal_handler);
+    (void)signal(SIGPIPE, SIG_IGN);
+    if (format == STREAM_FORMAT_CSV)
+    {
+        (void)fprintf(gs_stream_file, "sequence,timestamp_us,temperature_c,pressure_pa,humidity_percentage\n");
+    }
+    
+    /* loop */
+    ts.tv_sec = duration_us / 1000000;
+    ts.tv_nsec = (long)(duration_us % 1000000) * 1000;
+    timeout_ms = 2 * (duration_us / 1000) + 10;
+    timeouts = 0;
+    i = 0;
+    start_ns = (period_ns != 0) ? sched.next_ns : scheduler_get_time_ns();
+    
+    /* start the free running mode */
+    free_running = ((period_ns == 0) && (interrupt == BME680_BOOL_FALSE)) ? BME680_BOOL_TRUE : BME680_BOOL_FALSE;
+    trigger_ns = start_ns;
+    if ((free_running == BME680_BOOL_TRUE) && (bme680_sampler_continuous_start(0) != 0))
+    {
+        gs_stop = 1;
+    }
+    while ((gs_stop == 0) && ((times == 0) || (i < times)))
+    {
+        /* sleep for the rest of the running conversion, read it and trigger the next one */
+        if (free_running == BME680_BOOL_TRUE)
+        {
+            now_ns = scheduler_get_time_ns();
+            if (now_ns < trigger_ns + (uint64_t)duration_us * 1000)
+            {
+                rest.tv_sec = (time_t)((trigger_ns + (uint64_t)duration_us * 1000 - now_ns) / 1000000000);
+                rest.tv_nsec = (long)((trigger_ns + (uint64_t)duration_us * 1000 - now_ns) % 1000000000);
+                (void)nanosleep(&rest, NULL);
+            }
+            trigger_ns = scheduler_get_time_ns();
+            if (bme680_sampler_continuous_step((trigger_ns - start_ns) / 1000) == 1)
+            {
+                (void)bme680_sampler_continuous_start((trigger_ns - start_ns) / 1000);
+            }
+        }
+        else if (period_ns != 0)
+        {
+            /* wait for the next deadline */
+            res = scheduler_wait(&sched, (uint64_t *)&deadline_ns);
+            if (res == 2)
+            {
+                continue;
+            }
+            else if (res != 0)
+            {
+                break;
+            }
+        }
+        else
+        {
+            deadline_ns = scheduler_get_time_ns();
+        }
+        
+        /* trigger, wait for the conversion and read */
+        if ((free_running == BME680_BOOL_FALSE) && (bme680_sampler_trigger((deadline_ns - start_ns) / 1000) == 0))
+        {
+            if (interrupt == BME680_BOOL_TRUE)
+            {
+                if (gpio_interrupt_wait(timeout_ms, (uint64_t *)&edge_ns) != 0)
+                {
+                    timeouts++;
+                }
+            }
+            else
+            {
+                (void)nanosleep(&ts, NULL);
+            }
+            (void)bme680_sampler_complete();
+        }
+        
+        /* output */
+        while (bme680_sampler_pop(&frame) == 0)
+        {
+            if (a_stream_write(format, &frame) != 0)
+            {
+                gs_stop = 1;
+                
+                break;
+            }
+            i++;
+        }
+    }
+    if (free_running == BME680_BOOL_TRUE)
+    {
+        (void)bme680_sampler_continuous_stop();
+    }
+    deadline_ns = scheduler_get_time_ns();
+    seconds = (deadline_ns > start_ns) ? ((double)(deadline_ns - start_ns) / 1000000000.0) : 0.0;
+    (void)fflush(gs_stream_file);
+    
+    /* report */
+    (void)bme680_sampler_get_statistics(&overrun, &dropped, &failed);
+    (void)fprintf(stderr, "bme680: %u frames in %0.3fs, %0.2f frames/s.\n", i, seconds,
+                  (seconds > 0.0) ? ((double)i / seconds) : 0.0);
+    (void)fprintf(stderr, "bme680: dropped %u frames, failed %u reads.\n", dropped + overrun, failed);
+    if (interrupt == BME680_BOOL_TRUE)
+    {
+        (void)fprintf(stderr, "bme680: %u data ready interrupts timeout.\n", timeouts);
+    }
+    if (period_ns != 0)
+    {
+        (void)scheduler_get_statistics(&sched, &statistics);
+        (void)fprintf(stderr, "bme680: missed %u deadlines, jitter min %0.1fus mean %0.1fus max %0.1fus std %0.1fus.\n",
+                      statistics.missed, statistics.jitter_min_us, statistics.jitter_mean_us,
+                      statistics.jitter_max_us, statistics.jitter_std_us);
+    }
+    
+    /* restore the signal */
+    (void)signal(SIGINT, SIG_DFL);
+    (void)signal(SIGTERM, SIG_DFL);
+    
+    /* deinit */
+    if (interrupt == BME680_BOOL_TRUE)
+    {
+        (void)a_stream_interrupt_deinit();
+    }
+    (void)bme680_sampler_deinit();
+    a_stream_output_deinit();
+    
+    return 0;
+}
+
+/**
+ * @brief     init one handle with the basic example configuration
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] interface chip interface
+ * @param[in] addr chip address pin
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_handle_init(bme680_handle_t *handle, bme680_interface_t interface, bme680_address_t addr)
+{
+    /* link interface function */
+    DRIVER_BME680_LINK_INIT(handle, bme680_handle_t); 
+    DRIVER_BME680_LINK_IIC_INIT(handle, bme680_interface_iic_init);
+    DRIVER_BME680_LINK_IIC_DEINIT(handle, bme680_interface_iic_deinit);
+    DRIVER_BME680_LINK_IIC_READ(handle, bme680_interface_iic_read);
+    DRIVER_BME680_LINK_IIC_WRITE(handle, bme680_interface_iic_write);
+    DRIVER_BME680_LINK_SPI_INIT(handle, bme680_interface_spi_init);
+    DRIVER_BME680_LINK_SPI_DEINIT(handle, bme680_interface_spi_deinit);
+    DRIVER_BME680_LINK_SPI_READ(handle, bme680_interface_spi_read);
+    DRIVER_BME680_LINK_SPI_WRITE(handle, bme680_interface_spi_write);
+    DRIVER_BME680_LINK_DELAY_MS(handle, bme680_interface_delay_ms);
+    DRIVER_BME680_LINK_DEBUG_PRINT(handle, bme680_interface_debug_print);
+    DRIVER_BME680_LINK_BUS_LOCK(handle, bme680_interface_bus_lock);
+    DRIVER_BME680_LINK_BUS_UNLOCK(handle, bme680_interface_bus_unlock);
+    DRIVER_BME680_LINK_GET_TIME_MS(handle, bme680_interface_get_time_ms);
+    
+    /* init the chip */
+    if (bme680_set_interface(handle, interface) != 0)
+    {
+        return 1;
+    }
+    if (bme680_set_addr_pin(handle, addr) != 0)
+    {
+        return 1;
+    }
+    if (bme680_init(handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* set the basic example configuration without the gas */
+    if ((bme680_set_temperature_oversampling(handle, BME680_BASIC_DEFAULT_TEMPERATURE_OVERSAMPLING) != 0) ||
+        (bme680_set_pressure_oversampling(handle, BME680_BASIC_DEFAULT_PRESSURE_OVERSAMPLING) != 0) ||
+        (bme680_set_humidity_oversampling(handle, BME680_BASIC_DEFAULT_HUMIDITY_OVERSAMPLING) != 0) ||
+        (bme680_set_filter(handle, BME680_BASIC_DEFAULT_FILTER) != 0) ||
+        (bme680_set_spi_wire(handle, BME680_BASIC_DEFAULT_SPI_WIRE) != 0) ||
+        (bme680_set_run_gas(handle, BME680_BOOL_FALSE) != 0) ||
+        (bme680_set_mode(handle, BME680_MODE_SLEEP) != 0))
+    {
+        (void)bme680_deinit(handle);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the edf scheduler over the available sensors
+ * @param[in] interface chip interface
+ * @param[in] rate sample rate in hz of the first sensor and 0 means 10hz
+ * @param[in] times sample number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the iic interface schedules the sensors on both address pins and the second one runs at half the rate,
+ *            the spi interface schedules one sensor
+ */
+static uint8_t a_edf(bme680_interface_t interface, float rate, uint32_t times)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t index;
+    uint8_t number;
+    uint32_t samples;
+    uint32_t failures;
+    uint32_t period_us;
+    uint32_t completed;
+    uint32_t missed;
+    uint64_t start_ns;
+    uint64_t now_ns;
+    uint64_t next_us;
+    double seconds;
+    struct timespec rest;
+    bme680_handle_t handle[2];
+    bme680_edf_t edf;
+    bme680_edf_event_t event;
+    bme680_address_t addr[2] = {BME680_ADDRESS_ADO_LOW, BME680_ADDRESS_ADO_HIGH};
+    
+    /* add the available sensors */
+    (void)bme680_edf_init(&edf);
+    period_us = (uint32_t)(1000000.0f / ((rate > 0.0f) ? rate : 10.0f));
+    number = (interface == BME680_INTERFACE_IIC) ? 2 : 1;
+    start_ns = scheduler_get_time_ns();
+    for (i = 0; i < number; i++)
+    {
+        if (a_handle_init(&handle[edf.count], interface, addr[i]) != 0)
+        {
+            bme680_interface_debug_print("bme680: sensor %d is not available.\n", i);
+            
+            continue;
+        }
+        res = bme680_edf_add(&edf, &handle[edf.count], period_us * (i + 1), start_ns / 1000, (uint8_t *)&index);
+        if (res != 0)
+        {
+            bme680_interface_debug_print("bme680: add sensor %d failed.\n", i);
+            (void)bme680_deinit(&handle[edf.count]);
+            
+            continue;
+        }
+        bme680_interface_debug_print("bme680: sensor %d period %dus duration %dus.\n", index,
+                                     edf.sensor[index].period_us, edf.sensor[index].duration_us);
+    }
+    if (edf.count == 0)
+    {
+        return 1;
+    }
+    
+    /* loop */
+    samples = 0;
+    failures = 0;
+    while (samples < times)
+    {
+        now_ns = scheduler_get_time_ns();
+        if (bme680_edf_poll(&edf, now_ns / 1000, &event, (uint64_t *)&next_us) != 0)
+        {
+            /* the failed job is dropped, give up when no sensor answers any more */
+            failures++;
+            if (failures >= 10 * (uint32_t)edf.count)
+            {
+                bme680_interface_debug_print("bme680: edf poll failed %d times in a row.\n", failures);
+                for (i = 0; i < edf.count; i++)
+                {
+                    (void)bme680_deinit(&handle[i]);
+                }
+                
+                return 1;
+            }
+            
+            continue;
+        }
+        if (event.type == BME680_EDF_EVENT_SAMPLE)
+        {
+            failures = 0;
+            bme680_interface_debug_print("bme680: sensor %d %lluus %0.2fC %0.2fPa %0.2f%%.\n", event.index,
+                                         (unsigned long long)(event.release_us - start_ns / 1000), event.temperature_c,
+                                         event.pressure_pa, event.humidity_percentage);
+            samples++;
+        }
+        else if ((event.type == BME680_EDF_EVENT_NONE) && (next_us * 1000 > now_ns))
+        {
+            rest.tv_sec = (time_t)((next_us * 1000 - now_ns) / 1000000000);
+            rest.tv_nsec = (long)((next_us * 1000 - now_ns) % 1000000000);
+            (void)nanosleep(&rest, NULL);
+        }
+    }
+    now_ns = scheduler_get_time_ns();
+    seconds = (double)(now_ns - start_ns) / 1000000000.0;
+    
+    /* report */
+    for (i = 0; i < edf.count; i++)
+    {
+        (void)bme680_edf_get_statistics(&edf, i, (uint32_t *)&completed, (uint32_t *)&missed);
+        bme680_interface_debug_print("bme680: sensor %d completed %d, missed %d deadlines.\n", i, completed, missed);
+    }
+    bme680_interface_debug_print("bme680: %d samples in %0.3fs, %0.2f samples/s.\n", samples, seconds,
+                                 (seconds > 0.0) ? ((double)samples / seconds) : 0.0);
+    
+    /* deinit */
+    for (i = 0; i < edf.count; i++)
+    {
+        (void)bme680_deinit(&handle[i]);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the synchronized trigger over the iic sensors
+ * @param[in] batch bool value
+ * @param[in] period_us sample period in us
+ * @param[in] times sample round number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the sensors on both address pins are triggered together, the missing sensors are skipped
+ */
+static uint8_t a_sync(bme680_bool_t batch, uint32_t period_us, uint32_t times)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t index;
+    uint32_t t;
+    uint32_t skew_us;
+    uint32_t max_skew_us;
+    uint32_t worst_skew_us;
+    uint64_t trigger_us;
+    uint64_t start_us;
+    uint64_t elapsed_us;
+    float temperature;
+    float pressure;
+    float humidity_percentage;
+    bme680_handle_t handle[2];
+    bme680_sync_t sync;
+    bme680_address_t addr[2] = {BME680_ADDRESS_ADO_LOW, BME680_ADDRESS_ADO_HIGH};
+    
+    /* add the available sensors */
+    (void)bme680_sync_init(&sync, batch);
+    for (i = 0; i < 2; i++)
+    {
+        if (a_handle_init(&handle[sync.count], BME680_INTERFACE_IIC, addr[i]) != 0)
+        {
+            bme680_interface_debug_print("bme680: sensor %d is not available.\n", i);
+            
+            continue;
+        }
+        res = bme680_sync_add(&sync, &handle[sync.count], (uint8_t *)&index);
+        if (res != 0)
+        {
+            bme680_interface_debug_print("bme680: add sensor %d failed.\n", i);
+            (void)bme680_deinit(&handle[sync.count]);
+            
+            continue;
+        }
+    }
+    if (sync.count == 0)
+    {
+        return 1;
+    }
+    
+    /* loop */
+    res = 0;
+    worst_skew_us = 0;
+    for (t = 0; t < times; t++)
+    {
+        /* trigger */
+        start_us = bme680_interface_get_time_us();
+        if (bme680_sync_trigger(&sync, (uint32_t *)&max_skew_us) != 0)
+        {
+            bme680_interface_debug_print("bme680: trigger failed.\n");
+            res = 1;
+            
+            break;
+        }
+        if (max_skew_us > worst_skew_us)
+        {
+            worst_skew_us = max_skew_us;
+        }
+        bme680_interface_debug_print("bme680: %d/%d %d sensors, %d batched, max skew %dus.\n", t + 1, times,
+                                     sync.count, sync.batched, max_skew_us);
+        
+        /* read */
+        for (i = 0; i < sync.count; i++)
+        {
+            if (bme680_sync_read(&sync, i, &temperature, &pressure, &humidity_percentage) != 0)
+            {
+                bme680_interface_debug_print("bme680: read sensor %d failed.\n", i);
+                res = 1;
+                
+                continue;
+            }
+            (void)bme680_sync_get_trigger(&sync, i, (uint64_t *)&trigger_us, (uint32_t *)&skew_us);
+            bme680_interface_debug_print("bme680: sensor %d skew %dus %0.2fC %0.2fPa %0.2f%%.\n", i, skew_us,
+                                         temperature, pressure, humidity_percentage);
+        }
+        
+        /* wait the rest of the period */
+        if (t + 1 < times)
+        {
+            elapsed_us = bme680_interface_get_time_us() - start_us;
+            if (elapsed_us < period_us)
+            {
+                bme680_interface_delay_ms((uint32_t)((period_us - elapsed_us) / 1000));
+            }
+        }
+    }
+    bme680_interface_debug_print("bme680: worst skew %dus.\n", worst_skew_us);
+    
+    /* deinit */
+    for (i = 0; i < sync.count; i++)
+    {
+        (void)bme680_deinit(&handle[i]);
+    }
+    
+    return res;
+}
+
+/**
+ * @brief  find and init all sensors of the board
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   both iic address pins and the spi chip select are probed
+ */
+static uint8_t a_discover(void)
+{
+    uint8_t i;
+    uint8_t found;
+    uint64_t start_us;
+    uint64_t stop_us;
+    bme680_interface_t interface;
+    bme680_address_t addr_pin;
+    bme680_handle_t handle[3];
+    const bme680_discovery_candidate_t candidate[3] =
+    {
+        {BME680_INTERFACE_IIC, BME680_ADDRESS_ADO_LOW},
+        {BME680_INTERFACE_IIC, BME680_ADDRESS_ADO_HIGH},
+        {BME680_INTERFACE_SPI, BME680_ADDRESS_ADO_LOW},
+    };
+    
+    /* discover */
+    start_us = bme680_interface_get_time_us();
+    if (bme680_discovery_run(candidate, 3, handle, (uint8_t *)&found) != 0)
+    {
+        bme680_interface_debug_print("bme680: no sensor is found.\n");
+        
+        return 1;
+    }
+    stop_us = bme680_interface_get_time_us();
+    
+    /* report */
+    for (i = 0; i < found; i++)
+    {
+        (void)bme680_get_interface(&handle[i], &interface);
+        (void)bme680_get_addr_pin(&handle[i], &addr_pin);
+        if (interface == BME680_INTERFACE_IIC)
+        {
+            bme680_interface_debug_print("bme680: sensor %d on iic addr %d.\n", i,
+                                         (addr_pin == BME680_ADDRESS_ADO_LOW) ? 0 : 1);
+        }
+        else
+        {
+            bme680_interface_debug_print("bme680: sensor %d on spi.\n", i);
+        }
+    }
+    bme680_interface_debug_print("bme680: %d sensors brought up in %dus.\n", found, (uint32_t)(stop_us - start_us));
+    
+    /* deinit */
+    (void)bme680_discovery_deinit(handle, found);
+    
+    return 0;
+}
+
+/**
+ * @brief     run the oversampling and filter tuner
+ * @param[in] interface chip interface
+ * @param[in] addr chip address pin
+ * @param[in] rate target sample rate in hz and 0 means 10hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the noise targets are the tuner example defaults
+ */
+static uint8_t a_tune(bme680_interface_t interface, bme680_address_t addr, float rate)
+{
+    uint8_t res;
+    bme680_handle_t handle;
+    bme680_tuner_result_t result;
+    
+    /* init */
+    if (a_handle_init(&handle, interface, addr) != 0)
+    {
+        return 1;
+    }
+    
+    /* tune */
+    bme680_interface_debug_print("bme680: tuning for %0.1fhz, %0.3fC %0.2fPa %0.3f%% rms noise.\n", (rate > 0.0f) ? rate : 10.0f,
+                                 BME680_TUNER_DEFAULT_TEMPERATURE_NOISE_C, BME680_TUNER_DEFAULT_PRESSURE_NOISE_PA,
+                                 BME680_TUNER_DEFAULT_HUMIDITY_NOISE_PERCENTAGE);
+    res = bme680_tuner_run(&handle, (rate > 0.0f) ? rate : 10.0f, BME680_TUNER_DEFAULT_TEMPERATURE_NOISE_C,
+                           BME680_TUNER_DEFAULT_PRESSURE_NOISE_PA, BME680_TUNER_DEFAULT_HUMIDITY_NOISE_PERCENTAGE,
+                           &result);
+    if (res == 2)
+    {
+        bme680_interface_debug_print("bme680: no configuration meets the targets.\n");
+    }
+    else if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: tune failed.\n");
+    }
+    else
+    {
+        bme680_interface_debug_print("bme680: temperature oversampling x%d, noise %0.4fC.\n",
+                                     1 << (result.temperature_oversampling - 1), result.temperature_noise_c);
+        bme680_interface_debug_print("bme680: pressure oversampling x%d, noise %0.3fPa.\n",
+                                     1 << (result.pressure_oversampling - 1), result.pressure_noise_pa);
+        bme680_interface_debug_print("bme680: humidity oversampling x%d, noise %0.4f%%.\n",
+                                     1 << (result.humidity_oversampling - 1), result.humidity_noise_percentage);
+        bme680_interface_debug_print("bme680: filter coeff %d.\n", (1 << result.filter) - 1);
+        bme680_interface_debug_print("bme680: expected conversion time %dus.\n", result.duration_us);
+    }
+    
+    /* deinit */
+    (void)bme680_deinit(&handle);
+    
+    return (res == 1) ? 1 : 0;
+}
 
 /**
  * @brief     bme680 full function
@@ -69,6 +1580,14 @@ uint8_t bme680(uint8_t argc, char **argv)
         {"index", required_argument, NULL, 4},
         {"degree", required_argument, NULL, 5},
         {"wait", required_argument, NULL, 6},
+        {"rate", required_argument, NULL, 7},
+        {"format", required_argument, NULL, 8},
+        {"period", required_argument, NULL, 9},
+        {"interrupt", required_argument, NULL, 10},
+        {"threads", required_argument, NULL, 11},
+        {"adaptive", required_argument, NULL, 12},
+        {"gas-rate", required_argument, NULL, 13},
+        {"batch", required_argument, NULL, 14},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
@@ -76,6 +1595,14 @@ uint8_t bme680(uint8_t argc, char **argv)
     uint32_t times = 3;
     float degree_celsius = 200.0f;
     uint16_t gas_wait_ms = 150;
+    float rate = 0.0f;
+    float gas_rate = 0.1f;
+    uint32_t period_us = 1000000;
+    bme680_bool_t interrupt = BME680_BOOL_FALSE;
+    bme680_bool_t adaptive = BME680_BOOL_FALSE;
+    bme680_bool_t batch = BME680_BOOL_TRUE;
+    uint32_t threads = 4;
+    stream_format_t format = STREAM_FORMAT_CSV;
     bme680_interface_t interface = BME680_INTERFACE_IIC;
     bme680_address_t addr = BME680_ADDRESS_ADO_LOW;
     
@@ -222,6 +1749,141 @@ uint8_t bme680(uint8_t argc, char **argv)
                 break;
             }
             
+            /* rate */
+            case 7 :
+            {
+                /* set rate */
+                rate = (float)atof(optarg);
+                if (rate < 0.0f)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* format */
+            case 8 :
+            {
+                if (strcmp("csv", optarg) == 0)
+                {
+                    format = STREAM_FORMAT_CSV;
+                }
+                else if (strcmp("json", optarg) == 0)
+                {
+                    format = STREAM_FORMAT_JSON;
+                }
+                else if (strcmp("binary", optarg) == 0)
+                {
+                    format = STREAM_FORMAT_BINARY;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* period */
+            case 9 :
+            {
+                /* set period */
+                period_us = (uint32_t)atol(optarg);
+                if (period_us == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* interrupt */
+            case 10 :
+            {
+                /* set interrupt */
+                if (strcmp("true", optarg) == 0)
+                {
+                    interrupt = BME680_BOOL_TRUE;
+                }
+                else if (strcmp("false", optarg) == 0)
+                {
+                    interrupt = BME680_BOOL_FALSE;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* threads */
+            case 11 :
+            {
+                /* set threads */
+                threads = (uint32_t)atol(optarg);
+                if (threads == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* gas rate */
+            case 13 :
+            {
+                /* set gas rate */
+                gas_rate = (float)atof(optarg);
+                if (gas_rate <= 0.0f)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* adaptive */
+            case 12 :
+            {
+                /* set adaptive */
+                if (strcmp("true", optarg) == 0)
+                {
+                    adaptive = BME680_BOOL_TRUE;
+                }
+                else if (strcmp("false", optarg) == 0)
+                {
+                    adaptive = BME680_BOOL_FALSE;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* batch */
+            case 14 :
+            {
+                /* set batch */
+                if (strcmp("true", optarg) == 0)
+                {
+                    batch = BME680_BOOL_TRUE;
+                }
+                else if (strcmp("false", optarg) == 0)
+                {
+                    batch = BME680_BOOL_FALSE;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -270,6 +1932,9 @@ uint8_t bme680(uint8_t argc, char **argv)
         float temperature_c;
         float pressure_pa;
         float humidity_percentage;
+        uint64_t deadline_ns;
+        scheduler_t sched;
+        scheduler_statistics_t statistics;
         
         /* basic init */
         res = bme680_basic_init(interface, addr);
@@ -278,11 +1943,26 @@ uint8_t bme680(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* scheduler init */
+        res = scheduler_init(&sched, (uint64_t)period_us * 1000, SCHEDULER_ALIGN_SECOND);
+        if (res != 0)
+        {
+            (void)bme680_basic_deinit();
+            
+            return 1;
+        }
+        
         /* loop */
         for (i = 0; i < times; i++)
         {
-            /* delay 1000ms */
-            bme680_interface_delay_ms(1000);
+            /* wait for the next deadline */
+            res = scheduler_wait(&sched, (uint64_t *)&deadline_ns);
+            if (res != 0)
+            {
+                (void)bme680_basic_deinit();
+                
+                return 1;
+            }
             
             /* read data */
             res = bme680_basic_read((float *)&temperature_c, (float *)&pressure_pa, (float *)&humidity_percentage);
@@ -300,6 +1980,13 @@ uint8_t bme680(uint8_t argc, char **argv)
             bme680_interface_debug_print("bme680: humidity is %0.2f%%.\n", humidity_percentage);
         }
         
+        /* output the schedule */
+        (void)scheduler_get_statistics(&sched, &statistics);
+        bme680_interface_debug_print("bme680: missed %d deadlines.\n", statistics.missed);
+        bme680_interface_debug_print("bme680: jitter min is %0.1fus, mean is %0.1fus, max is %0.1fus, std is %0.1fus.\n",
+                                     statistics.jitter_min_us, statistics.jitter_mean_us,
+                                     statistics.jitter_max_us, statistics.jitter_std_us);
+        
         /* deinit */
         (void)bme680_basic_deinit();
         
@@ -313,6 +2000,10 @@ uint8_t bme680(uint8_t argc, char **argv)
         float pressure_pa;
         float humidity_percentage;
         float ohms;
+        uint16_t wait_ms;
+        uint64_t deadline_ns;
+        scheduler_t sched;
+        scheduler_statistics_t statistics;
         
         /* gas init */
         res = bme680_gas_init(interface, addr);
@@ -321,15 +2012,47 @@ uint8_t bme680(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* scheduler init */
+        res = scheduler_init(&sched, (uint64_t)period_us * 1000, SCHEDULER_ALIGN_SECOND);
+        if (res != 0)
+        {
+            (void)bme680_gas_deinit();
+            
+            return 1;
+        }
+        
         /* loop */
         for (i = 0; i < times; i++)
         {
-            /* delay 1000ms */
-            bme680_interface_delay_ms(1000);
+            /* wait for the next deadline */
+            res = scheduler_wait(&sched, (uint64_t *)&deadline_ns);
+            if (res != 0)
+            {
+                (void)bme680_gas_deinit();
+                
+                return 1;
+            }
             
             /* read data */
-            res = bme680_gas_read(degree_celsius, gas_wait_ms, index,
-                                 (float *)&temperature_c, (float *)&pressure_pa, (float *)&humidity_percentage, (float *)&ohms);
+            if (adaptive == BME680_BOOL_TRUE)
+            {
+                res = bme680_gas_adaptive_read(degree_celsius, gas_wait_ms, index,
+                                               (float *)&temperature_c, (float *)&pressure_pa, (float *)&humidity_percentage, (float *)&ohms,
+                                               (uint16_t *)&wait_ms);
+                if (res == 2)
+                {
+                    bme680_interface_debug_print("bme680: %d/%d.\n", i + 1, times);
+                    bme680_interface_debug_print("bme680: heater is not stable in %d ms and the gas wait backs off.\n", wait_ms);
+                    
+                    continue;
+                }
+            }
+            else
+            {
+                wait_ms = gas_wait_ms;
+                res = bme680_gas_read(degree_celsius, gas_wait_ms, index,
+                                     (float *)&temperature_c, (float *)&pressure_pa, (float *)&humidity_percentage, (float *)&ohms);
+            }
             if (res != 0)
             {
                 (void)bme680_gas_deinit();
@@ -344,15 +2067,241 @@ uint8_t bme680(uint8_t argc, char **argv)
             bme680_interface_debug_print("bme680: humidity is %0.2f%%.\n", humidity_percentage);
             bme680_interface_debug_print("bme680: gas index is %d.\n", index);
             bme680_interface_debug_print("bme680: degree celsius is %0.1fC.\n", degree_celsius);
-            bme680_interface_debug_print("bme680: gas wait is %d ms.\n", gas_wait_ms);
+            bme680_interface_debug_print("bme680: gas wait is %d ms.\n", wait_ms);
             bme680_interface_debug_print("bme680: gas resistance is %0.2fohms.\n", ohms);
         }
         
+        /* output the schedule */
+        (void)scheduler_get_statistics(&sched, &statistics);
+        bme680_interface_debug_print("bme680: missed %d deadlines.\n", statistics.missed);
+        bme680_interface_debug_print("bme680: jitter min is %0.1fus, mean is %0.1fus, max is %0.1fus, std is %0.1fus.\n",
+                                     statistics.jitter_min_us, statistics.jitter_mean_us,
+                                     statistics.jitter_max_us, statistics.jitter_std_us);
+        
+        /* deinit */
+        (void)bme680_gas_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_scan", type) == 0)
+    {
+        uint8_t res;
+        uint8_t j;
+        uint32_t i;
+        float profile_c[BME680_GAS_PROFILE_LEN];
+        uint16_t profile_ms[BME680_GAS_PROFILE_LEN];
+        float ohms[BME680_GAS_PROFILE_LEN];
+        uint64_t deadline_ns;
+        scheduler_t sched;
+        scheduler_statistics_t statistics;
+        
+        /* gas init */
+        res = bme680_gas_init(interface, addr);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* ramp the heater from the degree in 20C steps and upload the profile once */
+        for (j = 0; j < BME680_GAS_PROFILE_LEN; j++)
+        {
+            profile_c[j] = degree_celsius + 20.0f * j;
+            if (profile_c[j] > 400.0f)
+            {
+                profile_c[j] = 400.0f;
+            }
+            profile_ms[j] = gas_wait_ms;
+        }
+        res = bme680_gas_set_profile((float *)profile_c, (uint16_t *)profile_ms);
+        if (res != 0)
+        {
+            (void)bme680_gas_deinit();
+            
+            return 1;
+        }
+        
+        /* scheduler init */
+        res = scheduler_init(&sched, (uint64_t)period_us * 1000, SCHEDULER_ALIGN_SECOND);
+        if (res != 0)
+        {
+            (void)bme680_gas_deinit();
+            
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            /* wait for the next deadline */
+            res = scheduler_wait(&sched, (uint64_t *)&deadline_ns);
+            if (res != 0)
+            {
+                (void)bme680_gas_deinit();
+                
+                return 1;
+            }
+            
+            /* scan the profile */
+            res = bme680_gas_scan((float *)ohms);
+            if (res != 0)
+            {
+                (void)bme680_gas_deinit();
+                
+                return 1;
+            }
+            
+            /* output */
+            bme680_interface_debug_print("bme680: %d/%d.\n", i + 1, times);
+            for (j = 0; j < BME680_GAS_PROFILE_LEN; j++)
+            {
+                bme680_interface_debug_print("bme680: set point %d %0.1fC gas resistance is %0.2fohms.\n", j, profile_c[j], ohms[j]);
+            }
+        }
+        
+        /* output the schedule */
+        (void)scheduler_get_statistics(&sched, &statistics);
+        bme680_interface_debug_print("bme680: missed %d deadlines.\n", statistics.missed);
+        bme680_interface_debug_print("bme680: jitter min is %0.1fus, mean is %0.1fus, max is %0.1fus, std is %0.1fus.\n",
+                                     statistics.jitter_min_us, statistics.jitter_mean_us,
+                                     statistics.jitter_max_us, statistics.jitter_std_us);
+        
         /* deinit */
         (void)bme680_gas_deinit();
         
         return 0;
     }
+    else if (strcmp("e_multirate", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t frame_us;
+        uint32_t gas_every;
+        uint32_t gas_frames;
+        uint32_t switches;
+        uint64_t start_ns;
+        uint64_t deadline_ns;
+        scheduler_t sched;
+        scheduler_statistics_t statistics;
+        bme680_multirate_frame_t frame;
+        
+        /* multirate init, the temperature pressure and humidity rate defaults to 10hz */
+        res = bme680_multirate_init(interface, addr, (rate > 0.0f) ? rate : 10.0f, gas_rate,
+                                    degree_celsius, gas_wait_ms, (uint32_t *)&frame_us);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* scheduler init */
+        res = scheduler_init(&sched, (uint64_t)frame_us * 1000, SCHEDULER_ALIGN_SECOND);
+        if (res != 0)
+        {
+            (void)bme680_multirate_deinit();
+            
+            return 1;
+        }
+        
+        /* loop */
+        start_ns = sched.next_ns;
+        i = 0;
+        while (i < times)
+        {
+            /* wait for the next deadline, a missed one is retried without counting the frame */
+            res = scheduler_wait(&sched, (uint64_t *)&deadline_ns);
+            if (res == 2)
+            {
+                continue;
+            }
+            else if (res != 0)
+            {
+                (void)bme680_multirate_deinit();
+                
+                return 1;
+            }
+            
+            /* run the planned frame */
+            res = bme680_multirate_step((deadline_ns - start_ns) / 1000, &frame);
+            if (res == 1)
+            {
+                (void)bme680_multirate_deinit();
+                
+                return 1;
+            }
+            
+            /* output */
+            if ((frame.mask & BME680_OUTPUT_GAS) != 0)
+            {
+                bme680_interface_debug_print("bme680: %d %lluus %0.2fC %0.2fPa %0.2f%% %0.2fohms.\n", frame.sequence,
+                                             (unsigned long long)frame.timestamp_us, frame.temperature_c, frame.pressure_pa,
+                                             frame.humidity_percentage, frame.ohms);
+            }
+            else
+            {
+                bme680_interface_debug_print("bme680: %d %lluus %0.2fC %0.2fPa %0.2f%%.\n", frame.sequence,
+                                             (unsigned long long)frame.timestamp_us, frame.temperature_c, frame.pressure_pa,
+                                             frame.humidity_percentage);
+            }
+            i++;
+        }
+        
+        /* output the plan and the schedule */
+        (void)bme680_multirate_get_statistics((uint32_t *)&gas_every, (uint32_t *)&gas_frames, (uint32_t *)&switches);
+        bme680_interface_debug_print("bme680: one gas frame every %d frames, %d gas frames, %d run gas switches.\n",
+                                     gas_every, gas_frames, switches);
+        (void)scheduler_get_statistics(&sched, &statistics);
+        bme680_interface_debug_print("bme680: missed %d deadlines.\n", statistics.missed);
+        bme680_interface_debug_print("bme680: jitter min is %0.1fus, mean is %0.1fus, max is %0.1fus, std is %0.1fus.\n",
+                                     statistics.jitter_min_us, statistics.jitter_mean_us,
+                                     statistics.jitter_max_us, statistics.jitter_std_us);
+        
+        /* deinit */
+        (void)bme680_multirate_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_bench", type) == 0)
+    {
+        /* run the bench */
+        return a_bench(addr, degree_celsius, gas_wait_ms, index, times);
+    }
+    else if (strcmp("e_service", type) == 0)
+    {
+        /* run the service */
+        return a_service(interface, addr, threads, times);
+    }
+    else if (strcmp("e_stream", type) == 0)
+    {
+        /* the data ready interrupt is only output in the spi 3 wire mode */
+        if ((interrupt == BME680_BOOL_TRUE) && (interface != BME680_INTERFACE_SPI))
+        {
+            bme680_interface_debug_print("bme680: interrupt needs the spi interface.\n");
+            
+            return 5;
+        }
+        
+        /* run the stream */
+        return a_stream(interface, addr, rate, format, times, interrupt);
+    }
+    else if (strcmp("e_tune", type) == 0)
+    {
+        /* run the tuner */
+        return a_tune(interface, addr, rate);
+    }
+    else if (strcmp("e_edf", type) == 0)
+    {
+        /* run the edf scheduler */
+        return a_edf(interface, rate, times);
+    }
+    else if (strcmp("e_sync", type) == 0)
+    {
+        /* run the synchronized trigger */
+        return a_sync(batch, period_us, times);
+    }
+    else if (strcmp("e_discover", type) == 0)
+    {
+        /* run the discovery */
+        return a_discover();
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -362,24 +2311,44 @@ uint8_t bme680(uint8_t argc, char **argv)
         bme680_interface_debug_print("  bme680 (-p | --port)\n");
         bme680_interface_debug_print("  bme680 (-t reg | --test=reg) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
         bme680_interface_debug_print("  bme680 (-t read | --test=read) [--addr=<0 | 1>] [--interface=<iic | spi>] [--index=<index>] [--times=<num>]\n");
-        bme680_interface_debug_print("  bme680 (-e read | --example=read) [--addr=<0 | 1>] [--interface=<iic | spi>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e read | --example=read) [--addr=<0 | 1>] [--interface=<iic | spi>] [--period=<us>] [--times=<num>]\n");
         bme680_interface_debug_print("  bme680 (-e gas | --example=gas) [--addr=<0 | 1>] [--interface=<iic | spi>] [--index=<index>]\n");
+        bme680_interface_debug_print("         [--degree=<degree>] [--wait=<ms>] [--adaptive=<true | false>] [--period=<us>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e scan | --example=scan) [--addr=<0 | 1>] [--interface=<iic | spi>] [--degree=<degree>] [--wait=<ms>]\n");
+        bme680_interface_debug_print("         [--period=<us>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e multirate | --example=multirate) [--addr=<0 | 1>] [--interface=<iic | spi>] [--rate=<hz>] [--gas-rate=<hz>]\n");
         bme680_interface_debug_print("         [--degree=<degree>] [--wait=<ms>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e edf | --example=edf) [--interface=<iic | spi>] [--rate=<hz>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e tune | --example=tune) [--addr=<0 | 1>] [--interface=<iic | spi>] [--rate=<hz>]\n");
+        bme680_interface_debug_print("  bme680 (-e sync | --example=sync) [--batch=<true | false>] [--period=<us>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e discover | --example=discover)\n");
+        bme680_interface_debug_print("  bme680 (-e bench | --example=bench) [--addr=<0 | 1>] [--index=<index>] [--degree=<degree>] [--wait=<ms>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e service | --example=service) [--addr=<0 | 1>] [--interface=<iic | spi>] [--threads=<num>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e stream | --example=stream) [--addr=<0 | 1>] [--interface=<iic | spi>] [--rate=<hz>]\n");
+        bme680_interface_debug_print("         [--format=<csv | json | binary>] [--interrupt=<true | false>] [--times=<num>]\n");
         bme680_interface_debug_print("\n");
         bme680_interface_debug_print("Options:\n");
+        bme680_interface_debug_print("      --adaptive=<true | false>      Set the gas example to shrink the wait to the heater stability feedback.([default: false])\n");
         bme680_interface_debug_print("      --addr=<0 | 1>                 Set the chip iic address.([default: 0])\n");
-        bme680_interface_debug_print("      --degree=<degree>              Set the heater expected temperature in degree celsius.([default: 200.0])\n");
-        bme680_interface_debug_print("  -e <read | gas>, --example=<read | gas>\n");
+        bme680_interface_debug_print("      --batch=<true | false>         Set the sync triggers to go out in one iic transfer.([default: true])\n");
+        bme680_interface_debug_print("      --degree=<degree>              Set the heater expected temperature in degree celsius and the scan start.([default: 200.0])\n");
+        bme680_interface_debug_print("  -e <read | gas | scan | multirate | edf | tune | sync | discover | bench | service | stream>, --example=<read | gas | scan | multirate | edf | tune | sync | discover | bench | service | stream>\n");
         bme680_interface_debug_print("                                     Run the driver example.\n");
+        bme680_interface_debug_print("      --format=<csv | json | binary> Set the stream output format.([default: csv])\n");
+        bme680_interface_debug_print("      --gas-rate=<hz>                Set the multirate gas rate in hz.([default: 0.1])\n");
         bme680_interface_debug_print("  -h, --help                         Show the help.\n");
         bme680_interface_debug_print("  -i, --information                  Show the chip information.\n");
         bme680_interface_debug_print("      --index=<index>                Set the heater index and it range is 0 - 9.([default: 0])\n");
         bme680_interface_debug_print("      --interface=<iic | spi>        Set the chip interface.([default: iic])\n");
+        bme680_interface_debug_print("      --interrupt=<true | false>     Set the stream read triggered by the spi 3 wire data ready interrupt.([default: false])\n");
         bme680_interface_debug_print("  -p, --port                         Display the pin connections of the current board.\n");
+        bme680_interface_debug_print("      --period=<us>                  Set the read, gas, scan and sync example sample period in us.([default: 1000000])\n");
+        bme680_interface_debug_print("      --rate=<hz>                    Set the stream rate in hz and 0 means as fast as possible, the multirate, edf and tune 0 means 10hz.([default: 0])\n");
         bme680_interface_debug_print("  -t <reg | read>, --test=<reg | read>\n");
         bme680_interface_debug_print("                                     Run the driver test.\n");
-        bme680_interface_debug_print("      --times=<num>                  Set the running times.([default: 3])\n");
-        bme680_interface_debug_print("      --wait=<ms>                    Set the heater wait time in ms.([default: 150])\n");
+        bme680_interface_debug_print("      --threads=<num>                Set the service client thread number.([default: 4])\n");
+        bme680_interface_debug_print("      --times=<num>                  Set the running times and 0 means endless for the stream.([default: 3])\n");
+        bme680_interface_debug_print("      --wait=<ms>                    Set the heater wait time in ms and the max wait of the adaptive gas example.([default: 150])\n");
         
         return 0;
     }
@@ -408,6 +2377,7 @@ uint8_t bme680(uint8_t argc, char **argv)
         bme680_interface_debug_print("bme680: SPI interface MISO connected to GPIO9(BCM).\n");
         bme680_interface_debug_print("bme680: SPI interface MOSI connected to GPIO10(BCM).\n");
         bme680_interface_debug_print("bme680: SPI interface CS connected to GPIO8(BCM).\n");
+        bme680_interface_debug_print("bme680: SPI interface SDO(INT) connected to GPIO17(BCM) in 3 wire mode.\n");
         bme680_interface_debug_print("bme680: IIC interface SCL connected to GPIO3(BCM).\n");
         bme680_interface_debug_print("bme680: IIC interface SDA connected to GPIO2(BCM).\n");
         
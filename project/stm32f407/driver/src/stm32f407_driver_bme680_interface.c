@@ -41,6 +41,8 @@
 #include "uart.h"
 #include <stdarg.h>
 
+static volatile uint8_t gs_bus_locked[2] = {0, 0};        /**< iic and spi bus lock flags */
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -97,6 +99,32 @@ uint8_t bme680_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus write one register of several devices
+ * @param[in] *addr pointer to an iic device write address buffer
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer with one byte per device
+ * @param[in] count device number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the writes are issued back to back in the address order
+ */
+uint8_t bme680_interface_iic_write_batch(uint8_t *addr, uint8_t reg, uint8_t *buf, uint8_t count)
+{
+    uint8_t i;
+    
+    for (i = 0; i < count; i++)
+    {
+        if (iic_write(addr[i], reg, &buf[i], 1) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -151,6 +179,19 @@ uint8_t bme680_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
     return spi_write(reg, buf, len);
 }
 
+/**
+ * @brief     interface spi bus enable or disable the 3 wire mode
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set 3 wire failed
+ * @note      it is used by the data ready interrupt which needs the chip in the spi 3 wire mode
+ */
+uint8_t bme680_interface_spi_set_3_wire(uint8_t enable)
+{
+    return spi_set_3_wire(enable);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -180,3 +221,103 @@ void bme680_interface_debug_print(const char *const fmt, ...)
     len = strlen((char *)str);
     (void)uart_write((uint8_t *)str, len);
 }
+
+/**
+ * @brief     get the lock index of the handle bus
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    0 for the iic bus and 1 for the spi bus
+ * @note      none
+ */
+static uint8_t a_bme680_interface_bus_index(bme680_handle_t *handle)
+{
+    if (handle->iic_spi == BME680_INTERFACE_SPI)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface bus lock
+ * @param[in] *handle pointer to the bme680 handle which takes the bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 lock failed
+ * @note      the iic and the spi bus have their own lock flag, the irqs don't call the driver,
+ *            so a bus which is already held is a nested call and fails instead of waiting forever
+ */
+uint8_t bme680_interface_bus_lock(bme680_handle_t *handle)
+{
+    uint8_t bus;
+    uint32_t primask;
+    
+    bus = a_bme680_interface_bus_index(handle);
+    
+    /* test and set the flag in one critical section */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (gs_bus_locked[bus] != 0)
+    {
+        __set_PRIMASK(primask);
+        
+        return 1;
+    }
+    gs_bus_locked[bus] = 1;
+    __set_PRIMASK(primask);
+    
+    return 0;
+}
+
+/**
+ * @brief     interface bus unlock
+ * @param[in] *handle pointer to the bme680 handle which releases the bus
+ * @return    status code
+ *            - 0 success
+ *            - 1 unlock failed
+ * @note      unlocking a bus which is not held fails and doesn't touch the other bus
+ */
+uint8_t bme680_interface_bus_unlock(bme680_handle_t *handle)
+{
+    uint8_t bus;
+    
+    bus = a_bme680_interface_bus_index(handle);
+    if (gs_bus_locked[bus] == 0)
+    {
+        return 1;
+    }
+    gs_bus_locked[bus] = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  interface get time ms
+ * @return monotonic time in ms
+ * @note   none
+ */
+uint32_t bme680_interface_get_time_ms(void)
+{
+    return HAL_GetTick();
+}
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   the sub millisecond part is read from the systick counter
+ */
+uint64_t bme680_interface_get_time_us(void)
+{
+    uint32_t ms;
+    uint32_t val;
+    uint32_t load;
+    
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+    load = SysTick->LOAD + 1;
+    
+    return (uint64_t)ms * 1000 + (uint64_t)(load - val) * 1000 / load;
+}
@@ -79,6 +79,16 @@ uint8_t spi_init(spi_mode_t mode);
  */
 uint8_t spi_deinit(void);
 
+/**
+ * @brief     spi bus enable or disable the 3 wire mode
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set 3 wire failed
+ * @note      in the 3 wire mode MOSI(PA7) is used as the bidirectional data line
+ */
+uint8_t spi_set_3_wire(uint8_t enable);
+
 /**
  * @brief     spi bus write command
  * @param[in] *buf pointer to a data buffer
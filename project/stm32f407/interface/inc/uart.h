@@ -55,6 +55,11 @@ extern "C"{
 #define UART_MAX_LEN        256        /**< uart max len */
 #define UART2_MAX_LEN       512        /**< uart2 max len */
 
+/**
+ * @brief uart tx ring buffer length definition
+ */
+#define UART_TX_RING_LEN    2048       /**< uart tx ring len */
+
 /**
  * @brief     uart init with 8 data bits, 1 stop bit and no parity
  * @param[in] baud baud rate
@@ -74,6 +79,17 @@ uint8_t uart_init(uint32_t baud_rate);
  */
 uint8_t uart_deinit(void);
 
+/**
+ * @brief     uart enqueue data without waiting
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 tx buffer is full
+ * @note      the data is queued entirely or not at all and it can be called in the interrupt
+ */
+uint8_t uart_enqueue(uint8_t *buf, uint16_t len);
+
 /**
  * @brief     uart write data
  * @param[in] *buf pointer to a data buffer
@@ -81,7 +97,7 @@ uint8_t uart_deinit(void);
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      this function only waits for the free space of the tx buffer
  */
 uint8_t uart_write(uint8_t *buf, uint16_t len);
 
@@ -90,7 +106,8 @@ uint8_t uart_write(uint8_t *buf, uint16_t len);
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len data length
  * @return     length of the read data
- * @note       this function will clear all received buffer even read length is less than received length
+ * @note       this function doesn't wait and returns 0 until the idle line is detected,
+ *             it will clear all received buffer even read length is less than received length
  */
 uint16_t uart_read(uint8_t *buf, uint16_t len);
 
@@ -118,16 +135,37 @@ uint16_t uart_print(const char *const fmt, ...);
 UART_HandleTypeDef* uart_get_handle(void);
 
 /**
- * @brief uart set tx done
+ * @brief  uart get the dma tx handle
+ * @return pointer to a dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* uart_get_dma_tx_handle(void);
+
+/**
+ * @brief  uart get the dma rx handle
+ * @return pointer to a dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* uart_get_dma_rx_handle(void);
+
+/**
+ * @brief uart tx irq handler
  * @note  none
  */
-void uart_set_tx_done(void);
+void uart_tx_irq_handler(void);
+
+/**
+ * @brief     uart rx event irq handler
+ * @param[in] size dma rx buffer position
+ * @note      none
+ */
+void uart_rx_event_irq_handler(uint16_t size);
 
 /**
- * @brief uart irq handler
+ * @brief uart error irq handler
  * @note  none
  */
-void uart_irq_handler(void);
+void uart_error_irq_handler(void);
 
 /**
  * @brief     uart2 init with 8 data bits, 1 stop bit and no parity
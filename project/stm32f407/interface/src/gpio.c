@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio.c
+ * @brief     gpio source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpio.h"
+
+/**
+ * @brief gpio var definition
+ */
+static void (*gs_gpio_callback)(void) = NULL;        /**< gpio callback */
+
+/**
+ * @brief     gpio interrupt init
+ * @param[in] *callback pointer to an edge callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      PA6 rising edge on EXTI6, PA6 is the spi MISO and it is free in the spi 3 wire mode
+ */
+uint8_t gpio_interrupt_init(void (*callback)(void))
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    
+    /* save the callback */
+    gs_gpio_callback = callback;
+    
+    /* enable gpio clock */
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    
+    /* gpio init */
+    GPIO_InitStruct.Pin = GPIO_PIN_6;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+    GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    
+    /* clear the pending edge */
+    __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_6);
+    
+    /* enable nvic */
+    HAL_NVIC_SetPriority(EXTI9_5_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio interrupt deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   PA6 is returned to the spi MISO
+ */
+uint8_t gpio_interrupt_deinit(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+    
+    /* disable nvic */
+    HAL_NVIC_DisableIRQ(EXTI9_5_IRQn);
+    
+    /* gpio deinit */
+    HAL_GPIO_DeInit(GPIOA, GPIO_PIN_6);
+    gs_gpio_callback = NULL;
+    
+    /* PA6 ------> SPI1_MISO */
+    GPIO_InitStruct.Pin = GPIO_PIN_6;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF5_SPI1;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    
+    return 0;
+}
+
+/**
+ * @brief gpio irq handler
+ * @note  none
+ */
+void gpio_irq_handler(void)
+{
+    /* run the callback */
+    if (gs_gpio_callback != NULL)
+    {
+        gs_gpio_callback();
+    }
+}
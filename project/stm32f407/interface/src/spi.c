@@ -137,6 +137,31 @@ uint8_t spi_deinit(void)
     return 0;
 }
 
+/**
+ * @brief     spi bus enable or disable the 3 wire mode
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set 3 wire failed
+ * @note      in the 3 wire mode MOSI(PA7) is used as the bidirectional data line
+ */
+uint8_t spi_set_3_wire(uint8_t enable)
+{
+    /* disable the spi */
+    __HAL_SPI_DISABLE(&g_spi_handle);
+    
+    /* set the direction */
+    g_spi_handle.Init.Direction = (enable != 0) ? SPI_DIRECTION_1LINE : SPI_DIRECTION_2LINES;
+    
+    /* spi init again */
+    if (HAL_SPI_Init(&g_spi_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     spi bus write command
  * @param[in] *buf pointer to a data buffer
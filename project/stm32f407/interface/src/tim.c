@@ -0,0 +1,298 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      tim.c
+ * @brief     tim source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "tim.h"
+
+/**
+ * @brief tim var definition
+ */
+TIM_HandleTypeDef g_tim_handle;                      /**< tim handle */
+static void (*gs_tim_callback)(void) = NULL;         /**< tim callback */
+
+/**
+ * @brief tim oneshot var definition
+ */
+TIM_HandleTypeDef g_tim_oneshot_handle;                  /**< tim oneshot handle */
+static void (*gs_tim_oneshot_callback)(void) = NULL;     /**< tim oneshot callback */
+
+/**
+ * @brief  tim get the 1MHz prescaler
+ * @return prescaler
+ * @note   TIM2 and TIM5 run at 2 x PCLK1 when the apb1 prescaler is not 1
+ */
+static uint32_t a_tim_get_prescaler(void)
+{
+    uint32_t clk;
+    
+    /* get the timer clock */
+    clk = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1)
+    {
+        clk *= 2;
+    }
+    
+    return clk / 1000000 - 1;
+}
+
+/**
+ * @brief     tim init with a periodic update interrupt
+ * @param[in] us period in us
+ * @param[in] *callback pointer to a period callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      TIM2 with 1MHz counter clock
+ */
+uint8_t tim_init(uint32_t us, void (*callback)(void))
+{
+    /* check the period */
+    if (us == 0)
+    {
+        return 1;
+    }
+    
+    g_tim_handle.Instance = TIM2;
+    g_tim_handle.Init.Prescaler = a_tim_get_prescaler();
+    g_tim_handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    g_tim_handle.Init.Period = us - 1;
+    g_tim_handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    g_tim_handle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    
+    /* tim init */
+    if (HAL_TIM_Base_Init(&g_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* clear the update flag set by the init */
+    __HAL_TIM_CLEAR_FLAG(&g_tim_handle, TIM_FLAG_UPDATE);
+    
+    /* save the callback */
+    gs_tim_callback = callback;
+    
+    return 0;
+}
+
+/**
+ * @brief  tim deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t tim_deinit(void)
+{
+    /* tim deinit */
+    if (HAL_TIM_Base_DeInit(&g_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    gs_tim_callback = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief  tim start
+ * @return status code
+ *         - 0 success
+ *         - 1 start failed
+ * @note   none
+ */
+uint8_t tim_start(void)
+{
+    /* reset the counter */
+    __HAL_TIM_SET_COUNTER(&g_tim_handle, 0);
+    
+    /* start with the update interrupt */
+    if (HAL_TIM_Base_Start_IT(&g_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  tim stop
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   none
+ */
+uint8_t tim_stop(void)
+{
+    /* stop the timer */
+    if (HAL_TIM_Base_Stop_IT(&g_tim_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  tim get the handle
+ * @return pointer to a tim handle
+ * @note   none
+ */
+TIM_HandleTypeDef* tim_get_handle(void)
+{
+    return &g_tim_handle;
+}
+
+/**
+ * @brief tim irq handler
+ * @note  none
+ */
+void tim_irq_handler(void)
+{
+    /* run the callback */
+    if (gs_tim_callback != NULL)
+    {
+        gs_tim_callback();
+    }
+}
+
+/**
+ * @brief     tim oneshot init
+ * @param[in] *callback pointer to an expired callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      TIM5 with 1MHz counter clock
+ */
+uint8_t tim_oneshot_init(void (*callback)(void))
+{
+    g_tim_oneshot_handle.Instance = TIM5;
+    g_tim_oneshot_handle.Init.Prescaler = a_tim_get_prescaler();
+    g_tim_oneshot_handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    g_tim_oneshot_handle.Init.Period = 0xFFFFFFFFU;
+    g_tim_oneshot_handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    g_tim_oneshot_handle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    
+    /* tim init */
+    if (HAL_TIM_Base_Init(&g_tim_oneshot_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    /* clear the update flag set by the init */
+    __HAL_TIM_CLEAR_FLAG(&g_tim_oneshot_handle, TIM_FLAG_UPDATE);
+    
+    /* save the callback */
+    gs_tim_oneshot_callback = callback;
+    
+    return 0;
+}
+
+/**
+ * @brief  tim oneshot deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t tim_oneshot_deinit(void)
+{
+    /* tim deinit */
+    if (HAL_TIM_Base_DeInit(&g_tim_oneshot_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    gs_tim_oneshot_callback = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief     tim oneshot start
+ * @param[in] us delay in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      it can be called in the interrupt
+ */
+uint8_t tim_oneshot_start(uint32_t us)
+{
+    /* check the delay */
+    if (us == 0)
+    {
+        return 1;
+    }
+    
+    /* stop the last one */
+    (void)HAL_TIM_Base_Stop_IT(&g_tim_oneshot_handle);
+    
+    /* set the delay */
+    __HAL_TIM_SET_AUTORELOAD(&g_tim_oneshot_handle, us - 1);
+    __HAL_TIM_SET_COUNTER(&g_tim_oneshot_handle, 0);
+    __HAL_TIM_CLEAR_FLAG(&g_tim_oneshot_handle, TIM_FLAG_UPDATE);
+    
+    /* start with the update interrupt */
+    if (HAL_TIM_Base_Start_IT(&g_tim_oneshot_handle) != HAL_OK)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  tim oneshot get the handle
+ * @return pointer to a tim handle
+ * @note   none
+ */
+TIM_HandleTypeDef* tim_oneshot_get_handle(void)
+{
+    return &g_tim_oneshot_handle;
+}
+
+/**
+ * @brief tim oneshot irq handler
+ * @note  none
+ */
+void tim_oneshot_irq_handler(void)
+{
+    /* stop the timer */
+    (void)HAL_TIM_Base_Stop_IT(&g_tim_oneshot_handle);
+    
+    /* run the callback */
+    if (gs_tim_oneshot_callback != NULL)
+    {
+        gs_tim_oneshot_callback();
+    }
+}
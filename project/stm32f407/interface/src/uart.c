@@ -42,11 +42,18 @@
 /**
  * @brief uart1 var definition
  */
-UART_HandleTypeDef g_uart_handle;              /**< uart handle */
-uint8_t g_uart_rx_buffer[UART_MAX_LEN];        /**< uart rx buffer */
-uint8_t g_uart_buffer;                         /**< uart one buffer */
-volatile uint16_t g_uart_point;                /**< uart rx point */
-volatile uint8_t g_uart_tx_done;               /**< uart tx done flag */
+UART_HandleTypeDef g_uart_handle;                    /**< uart handle */
+DMA_HandleTypeDef g_uart_dma_tx_handle;              /**< uart dma tx handle */
+DMA_HandleTypeDef g_uart_dma_rx_handle;              /**< uart dma rx handle */
+uint8_t g_uart_rx_buffer[UART_MAX_LEN];              /**< uart rx buffer */
+uint8_t g_uart_dma_rx_buffer[UART_MAX_LEN];          /**< uart dma rx buffer */
+volatile uint16_t g_uart_dma_rx_point;               /**< uart dma rx point */
+volatile uint16_t g_uart_point;                      /**< uart rx point */
+volatile uint8_t g_uart_rx_done;                     /**< uart rx done flag */
+uint8_t g_uart_tx_ring[UART_TX_RING_LEN];            /**< uart tx ring buffer */
+volatile uint32_t g_uart_tx_head;                    /**< uart tx ring write point */
+volatile uint32_t g_uart_tx_tail;                    /**< uart tx ring read point */
+volatile uint16_t g_uart_tx_len;                     /**< uart running dma tx length */
 
 /**
  * @brief uart2 var definition
@@ -76,18 +83,29 @@ uint8_t uart_init(uint32_t baud)
     g_uart_handle.Init.HwFlowCtl = UART_HWCONTROL_NONE;
     g_uart_handle.Init.OverSampling = UART_OVERSAMPLING_16;
     
+    /* reset the buffer */
+    g_uart_dma_rx_point = 0;
+    g_uart_point = 0;
+    g_uart_rx_done = 0;
+    g_uart_tx_head = 0;
+    g_uart_tx_tail = 0;
+    g_uart_tx_len = 0;
+    
     /* uart init */
     if (HAL_UART_Init(&g_uart_handle) != HAL_OK)
     {
         return 1;
     }
     
-    /* receive one byte */
-    if (HAL_UART_Receive_IT(&g_uart_handle, (uint8_t *)&g_uart_buffer, 1) != HAL_OK)
+    /* receive until the idle line */
+    if (HAL_UARTEx_ReceiveToIdle_DMA(&g_uart_handle, g_uart_dma_rx_buffer, UART_MAX_LEN) != HAL_OK)
     {
         return 1;
     }
     
+    /* disable the half transfer interrupt */
+    __HAL_DMA_DISABLE_IT(&g_uart_dma_rx_handle, DMA_IT_HT);
+    
     return 0;
 }
 
@@ -109,6 +127,83 @@ uint8_t uart_deinit(void)
     return 0;
 }
 
+/**
+ * @brief start the next dma transmission
+ * @note  call it with the interrupt disabled
+ */
+static void a_uart_tx_start(void)
+{
+    uint32_t index;
+    uint32_t len;
+    
+    /* check the running transmission */
+    if ((g_uart_tx_len != 0) || (g_uart_tx_head == g_uart_tx_tail))
+    {
+        return;
+    }
+    
+    /* get the continuous length */
+    index = g_uart_tx_tail % UART_TX_RING_LEN;
+    len = g_uart_tx_head - g_uart_tx_tail;
+    if (len > UART_TX_RING_LEN - index)
+    {
+        len = UART_TX_RING_LEN - index;
+    }
+    
+    /* transmit */
+    if (HAL_UART_Transmit_DMA(&g_uart_handle, (uint8_t *)&g_uart_tx_ring[index], (uint16_t)len) == HAL_OK)
+    {
+        g_uart_tx_len = (uint16_t)len;
+    }
+}
+
+/**
+ * @brief     uart enqueue data without waiting
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 tx buffer is full
+ * @note      the data is queued entirely or not at all and it can be called in the interrupt
+ */
+uint8_t uart_enqueue(uint8_t *buf, uint16_t len)
+{
+    uint32_t primask;
+    uint32_t index;
+    uint32_t first;
+    
+    /* enter critical */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    
+    /* check the free space */
+    if ((uint32_t)len > UART_TX_RING_LEN - (g_uart_tx_head - g_uart_tx_tail))
+    {
+        __set_PRIMASK(primask);
+        
+        return 1;
+    }
+    
+    /* copy the data */
+    index = g_uart_tx_head % UART_TX_RING_LEN;
+    first = UART_TX_RING_LEN - index;
+    if (first > len)
+    {
+        first = len;
+    }
+    memcpy(&g_uart_tx_ring[index], buf, first);
+    memcpy(&g_uart_tx_ring[0], buf + first, len - first);
+    g_uart_tx_head += len;
+    
+    /* start the transmission */
+    a_uart_tx_start();
+    
+    /* exit critical */
+    __set_PRIMASK(primask);
+    
+    return 0;
+}
+
 /**
  * @brief     uart write data
  * @param[in] *buf pointer to a data buffer
@@ -116,37 +211,30 @@ uint8_t uart_deinit(void)
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      this function only waits for the free space of the tx buffer
  */
 uint8_t uart_write(uint8_t *buf, uint16_t len)
 {
     uint16_t timeout = 1000;
     
-    /* set tx done 0 */
-    g_uart_tx_done = 0;
-    
-    /* transmit */
-    if (HAL_UART_Transmit_IT(&g_uart_handle, (uint8_t *)buf, len) != HAL_OK)
+    /* check the length */
+    if (len > UART_TX_RING_LEN)
     {
         return 1;
     }
     
-    /* wait for events */
-    while ((g_uart_tx_done == 0) && (timeout != 0))
+    /* wait for the free space */
+    while (uart_enqueue(buf, len) != 0)
     {
+        if (timeout == 0)
+        {
+            return 1;
+        }
         HAL_Delay(1);
         timeout--;
     }
     
-    /* check the timeout */
-    if (timeout != 0)
-    {
-        return 0;
-    }
-    else
-    {
-        return 1;
-    }
+    return 0;
 }
 
 /**
@@ -154,28 +242,34 @@ uint8_t uart_write(uint8_t *buf, uint16_t len)
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len data length
  * @return     length of the read data
- * @note       this function will clear all received buffer even read length is less than received length
+ * @note       this function doesn't wait and returns 0 until the idle line is detected,
+ *             it will clear all received buffer even read length is less than received length
  */
 uint16_t uart_read(uint8_t *buf, uint16_t len)
 {
     uint16_t read_len;
-    uint16_t g_uart_point_old;
+    uint32_t primask;
     
-    /* check receiving */
-    start:
-    g_uart_point_old = g_uart_point;
-    HAL_Delay(1);
-    if (g_uart_point > g_uart_point_old)
+    /* check the idle line */
+    if (g_uart_rx_done == 0)
     {
-        goto start;
+        return 0;
     }
     
+    /* enter critical */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    
     /* copy the data */
     read_len = (len < g_uart_point) ? len : g_uart_point;
     memcpy(buf, g_uart_rx_buffer, read_len);
     
     /* clear the buffer */
     g_uart_point = 0;
+    g_uart_rx_done = 0;
+    
+    /* exit critical */
+    __set_PRIMASK(primask);
     
     return read_len;
 }
@@ -190,6 +284,7 @@ uint16_t uart_flush(void)
 {
     /* clear the buffer */
     g_uart_point = 0;
+    g_uart_rx_done = 0;
     
     return 0;
 }
@@ -382,12 +477,37 @@ UART_HandleTypeDef* uart2_get_handle(void)
 }
 
 /**
- * @brief uart set tx done
+ * @brief  uart get the dma tx handle
+ * @return pointer to a dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* uart_get_dma_tx_handle(void)
+{
+    return &g_uart_dma_tx_handle;
+}
+
+/**
+ * @brief  uart get the dma rx handle
+ * @return pointer to a dma handle
+ * @note   none
+ */
+DMA_HandleTypeDef* uart_get_dma_rx_handle(void)
+{
+    return &g_uart_dma_rx_handle;
+}
+
+/**
+ * @brief uart tx irq handler
  * @note  none
  */
-void uart_set_tx_done(void)
+void uart_tx_irq_handler(void)
 {
-    g_uart_tx_done = 1;
+    /* release the sent data */
+    g_uart_tx_tail += g_uart_tx_len;
+    g_uart_tx_len = 0;
+    
+    /* start the next transmission */
+    a_uart_tx_start();
 }
 
 /**
@@ -400,21 +520,50 @@ void uart2_set_tx_done(void)
 }
 
 /**
- * @brief uart irq handler
+ * @brief     uart rx event irq handler
+ * @param[in] size dma rx buffer position
+ * @note      none
+ */
+void uart_rx_event_irq_handler(uint16_t size)
+{
+    /* save the new bytes */
+    size = size % UART_MAX_LEN;
+    while (g_uart_dma_rx_point != size)
+    {
+        g_uart_rx_buffer[g_uart_point] = g_uart_dma_rx_buffer[g_uart_dma_rx_point];
+        g_uart_point++;
+        if (g_uart_point > (UART_MAX_LEN - 1))
+        {
+            g_uart_point = 0;
+        }
+        g_uart_dma_rx_point = (g_uart_dma_rx_point + 1) % UART_MAX_LEN;
+    }
+    
+    /* set rx done */
+    g_uart_rx_done = 1;
+}
+
+/**
+ * @brief uart error irq handler
  * @note  none
  */
-void uart_irq_handler(void)
+void uart_error_irq_handler(void)
 {
-    /* save one byte */
-    g_uart_rx_buffer[g_uart_point] = g_uart_buffer;
-    g_uart_point++;
-    if (g_uart_point > (UART_MAX_LEN - 1))
+    /* restart receiving after the dma is aborted */
+    if (g_uart_handle.RxState == HAL_UART_STATE_READY)
     {
-        g_uart_point = 0;
+        g_uart_dma_rx_point = 0;
+        if (HAL_UARTEx_ReceiveToIdle_DMA(&g_uart_handle, g_uart_dma_rx_buffer, UART_MAX_LEN) == HAL_OK)
+        {
+            __HAL_DMA_DISABLE_IT(&g_uart_dma_rx_handle, DMA_IT_HT);
+        }
     }
     
-    /* receive one byte */
-    (void)HAL_UART_Receive_IT(&g_uart_handle, (uint8_t *)&g_uart_buffer, 1);
+    /* release the aborted transmission */
+    if ((g_uart_tx_len != 0) && (g_uart_handle.gState == HAL_UART_STATE_READY))
+    {
+        uart_tx_irq_handler();
+    }
 }
 
 /**
@@ -114,6 +114,36 @@ void USART1_IRQHandler(void);
  */
 void USART2_IRQHandler(void);
 
+/**
+ * @brief dma2 stream2 irq handler
+ * @note  none
+ */
+void DMA2_Stream2_IRQHandler(void);
+
+/**
+ * @brief dma2 stream7 irq handler
+ * @note  none
+ */
+void DMA2_Stream7_IRQHandler(void);
+
+/**
+ * @brief tim2 irq handler
+ * @note  none
+ */
+void TIM2_IRQHandler(void);
+
+/**
+ * @brief tim5 irq handler
+ * @note  none
+ */
+void TIM5_IRQHandler(void);
+
+/**
+ * @brief exti9_5 irq handler
+ * @note  none
+ */
+void EXTI9_5_IRQHandler(void);
+
 /**
  * @}
  */
@@ -38,10 +38,14 @@
 #include "driver_bme680_register_test.h"
 #include "driver_bme680_basic.h"
 #include "driver_bme680_gas.h"
+#include "driver_bme680_sampler.h"
 #include "shell.h"
 #include "clock.h"
 #include "delay.h"
 #include "uart.h"
+#include "tim.h"
+#include "gpio.h"
+#include "spi.h"
 #include "getopt.h"
 #include <stdlib.h>
 
@@ -50,6 +54,280 @@
  */
 uint8_t g_buf[256];        /**< uart buffer */
 volatile uint16_t g_len;   /**< uart buffer length */
+static volatile uint64_t gs_sampler_timestamp_us;        /**< sampler timestamp */
+static volatile uint32_t gs_sampler_period_us;           /**< sampler period */
+static volatile uint32_t gs_sampler_duration_us;         /**< sampler conversion duration */
+static volatile bme680_bool_t gs_sampler_interrupt;      /**< sampler data ready interrupt */
+static volatile uint8_t gs_sampler_trigger_flag;         /**< sampler trigger pending flag */
+static volatile uint8_t gs_sampler_complete_flag;        /**< sampler completion pending flag */
+
+/**
+ * @brief sampler period callback
+ * @note  it runs in the tim2 irq and only flags the trigger
+ */
+static void a_sampler_period_callback(void)
+{
+    /* update the timestamp */
+    gs_sampler_timestamp_us += gs_sampler_period_us;
+    
+    /* flag the trigger */
+    gs_sampler_trigger_flag = 1;
+}
+
+/**
+ * @brief sampler completion callback
+ * @note  it runs in the tim5 or exti6 irq and only flags the completion
+ */
+static void a_sampler_complete_callback(void)
+{
+    /* flag the completion */
+    gs_sampler_complete_flag = 1;
+}
+
+/**
+ * @brief sampler run the flagged bus transfers
+ * @note  call it from the main loop, the completion runs first so a pending trigger finds the sampler free
+ */
+static void a_sampler_poll(void)
+{
+    uint32_t primask;
+    uint64_t timestamp_us;
+    
+    /* read the conversion */
+    if (gs_sampler_complete_flag != 0)
+    {
+        gs_sampler_complete_flag = 0;
+        (void)bme680_sampler_complete();
+    }
+    
+    /* trigger one conversion */
+    if (gs_sampler_trigger_flag != 0)
+    {
+        /* the timestamp is 64 bits, read it with the flag in one critical section */
+        primask = __get_PRIMASK();
+        __disable_irq();
+        timestamp_us = gs_sampler_timestamp_us;
+        gs_sampler_trigger_flag = 0;
+        __set_PRIMASK(primask);
+        
+        if (bme680_sampler_trigger(timestamp_us) == 0)
+        {
+            /* start the completion timer if no data ready interrupt */
+            if (gs_sampler_interrupt == BME680_BOOL_FALSE)
+            {
+                (void)tim_oneshot_start(gs_sampler_duration_us);
+            }
+        }
+    }
+}
+
+/**
+ * @brief sampler sleep until the next interrupt
+ * @note  a masked irq still wakes the core, so a flag set between the check and the wfi is not lost
+ */
+static void a_sampler_sleep(void)
+{
+    __disable_irq();
+    if ((gs_sampler_trigger_flag == 0) && (gs_sampler_complete_flag == 0))
+    {
+        __WFI();
+    }
+    __enable_irq();
+}
+
+/**
+ * @brief     sampler enable or disable the data ready interrupt
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the chip and spi1 are switched together and the chip sdo drives PA6 in the 3 wire mode
+ */
+static uint8_t a_sampler_set_interrupt(bme680_bool_t enable)
+{
+    uint8_t res;
+    
+    if (enable == BME680_BOOL_TRUE)
+    {
+        /* switch the chip to the 3 wire mode with the data ready interrupt */
+        if (bme680_sampler_set_data_interrupt(BME680_BOOL_TRUE) != 0)
+        {
+            return 1;
+        }
+        
+        /* follow the chip wire mode */
+        if (spi_set_3_wire(1) != 0)
+        {
+            return 1;
+        }
+        
+        /* complete the conversion in the edge interrupt */
+        return gpio_interrupt_init(a_sampler_complete_callback);
+    }
+    else
+    {
+        res = 0;
+        
+        /* switch the chip back to the 4 wire mode */
+        if (bme680_sampler_set_data_interrupt(BME680_BOOL_FALSE) != 0)
+        {
+            res = 1;
+        }
+        
+        /* follow the chip wire mode */
+        if (spi_set_3_wire(0) != 0)
+        {
+            res = 1;
+        }
+        
+        /* return PA6 to the spi */
+        if (gpio_interrupt_deinit() != 0)
+        {
+            res = 1;
+        }
+        
+        return res;
+    }
+}
+
+/**
+ * @brief sampler completion deinit
+ * @note  none
+ */
+static void a_sampler_completion_deinit(void)
+{
+    if (gs_sampler_interrupt == BME680_BOOL_TRUE)
+    {
+        (void)a_sampler_set_interrupt(BME680_BOOL_FALSE);
+    }
+    else
+    {
+        (void)tim_oneshot_deinit();
+    }
+}
+
+/**
+ * @brief     sampler start
+ * @param[in] interface chip interface
+ * @param[in] addr chip address pin
+ * @param[in] period_us timer period in us
+ * @param[in] interrupt bool value and true means the conversion is completed by the data ready interrupt
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 5 param is invalid
+ * @note      the data ready interrupt is only output in the spi 3 wire mode
+ */
+static uint8_t a_sampler_start(bme680_interface_t interface, bme680_address_t addr, uint32_t period_us,
+                               bme680_bool_t interrupt)
+{
+    uint8_t res;
+    uint32_t duration_us;
+    
+    /* check the interface */
+    if ((interrupt == BME680_BOOL_TRUE) && (interface != BME680_INTERFACE_SPI))
+    {
+        bme680_interface_debug_print("bme680: interrupt needs the spi interface.\n");
+        
+        return 5;
+    }
+    
+    /* sampler init */
+    res = bme680_sampler_init(interface, addr, &duration_us);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* check the period */
+    if (period_us <= duration_us)
+    {
+        bme680_interface_debug_print("bme680: period must be greater than the conversion time %dus.\n", duration_us);
+        (void)bme680_sampler_deinit();
+        
+        return 5;
+    }
+    gs_sampler_timestamp_us = 0;
+    gs_sampler_period_us = period_us;
+    gs_sampler_duration_us = duration_us;
+    gs_sampler_interrupt = interrupt;
+    gs_sampler_trigger_flag = 0;
+    gs_sampler_complete_flag = 0;
+    
+    /* completion init */
+    if (interrupt == BME680_BOOL_TRUE)
+    {
+        res = a_sampler_set_interrupt(BME680_BOOL_TRUE);
+        if (res != 0)
+        {
+            bme680_interface_debug_print("bme680: set data interrupt failed.\n");
+            (void)a_sampler_set_interrupt(BME680_BOOL_FALSE);
+            (void)bme680_sampler_deinit();
+            
+            return 1;
+        }
+    }
+    else
+    {
+        res = tim_oneshot_init(a_sampler_complete_callback);
+        if (res != 0)
+        {
+            (void)bme680_sampler_deinit();
+            
+            return 1;
+        }
+    }
+    
+    /* period timer init */
+    res = tim_init(period_us, a_sampler_period_callback);
+    if (res != 0)
+    {
+        a_sampler_completion_deinit();
+        (void)bme680_sampler_deinit();
+        
+        return 1;
+    }
+    
+    /* output */
+    bme680_interface_debug_print("bme680: period is %dus.\n", period_us);
+    bme680_interface_debug_print("bme680: conversion time is %dus.\n", duration_us);
+    
+    /* start the period timer */
+    res = tim_start();
+    if (res != 0)
+    {
+        (void)tim_deinit();
+        a_sampler_completion_deinit();
+        (void)bme680_sampler_deinit();
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief sampler stop
+ * @note  none
+ */
+static void a_sampler_stop(void)
+{
+    uint32_t overrun;
+    uint32_t dropped;
+    uint32_t failed;
+    
+    /* stop the timers */
+    (void)tim_stop();
+    (void)tim_deinit();
+    a_sampler_completion_deinit();
+    
+    /* output the statistics */
+    (void)bme680_sampler_get_statistics(&overrun, &dropped, &failed);
+    bme680_interface_debug_print("bme680: overrun %d, dropped %d, failed %d.\n", overrun, dropped, failed);
+    
+    /* deinit */
+    (void)bme680_sampler_deinit();
+}
 
 /**
  * @brief     bme680 full function
@@ -79,6 +357,8 @@ uint8_t bme680(uint8_t argc, char **argv)
         {"index", required_argument, NULL, 4},
         {"degree", required_argument, NULL, 5},
         {"wait", required_argument, NULL, 6},
+        {"period", required_argument, NULL, 7},
+        {"interrupt", required_argument, NULL, 8},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
@@ -86,6 +366,8 @@ uint8_t bme680(uint8_t argc, char **argv)
     uint32_t times = 3;
     float degree_celsius = 200.0f;
     uint16_t gas_wait_ms = 150;
+    uint32_t period_us = 1000000;
+    bme680_bool_t interrupt = BME680_BOOL_FALSE;
     bme680_interface_t interface = BME680_INTERFACE_IIC;
     bme680_address_t addr = BME680_ADDRESS_ADO_LOW;
     
@@ -232,6 +514,35 @@ uint8_t bme680(uint8_t argc, char **argv)
                 break;
             }
             
+            /* period */
+            case 7 :
+            {
+                /* set period */
+                period_us = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* interrupt */
+            case 8 :
+            {
+                /* set interrupt */
+                if (strcmp("true", optarg) == 0)
+                {
+                    interrupt = BME680_BOOL_TRUE;
+                }
+                else if (strcmp("false", optarg) == 0)
+                {
+                    interrupt = BME680_BOOL_FALSE;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -363,6 +674,109 @@ uint8_t bme680(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("e_sampler", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        bme680_sampler_frame_t frame;
+        
+        /* sampler start */
+        res = a_sampler_start(interface, addr, period_us, interrupt);
+        if (res != 0)
+        {
+            return res;
+        }
+        
+        /* loop */
+        i = 0;
+        while (i < times)
+        {
+            /* run the bus transfers flagged by the irqs */
+            a_sampler_poll();
+            
+            /* pop one frame */
+            if (bme680_sampler_pop(&frame) != 0)
+            {
+                /* sleep until the next interrupt */
+                a_sampler_sleep();
+                
+                continue;
+            }
+            i++;
+            
+            /* output */
+            bme680_interface_debug_print("bme680: %d/%d.\n", i, times);
+            bme680_interface_debug_print("bme680: sequence is %d.\n", frame.sequence);
+            bme680_interface_debug_print("bme680: timestamp is %dus.\n", (uint32_t)frame.timestamp_us);
+            bme680_interface_debug_print("bme680: temperature is %0.2fC.\n", frame.temperature_c);
+            bme680_interface_debug_print("bme680: pressure is %0.2fPa.\n", frame.pressure_pa);
+            bme680_interface_debug_print("bme680: humidity is %0.2f%%.\n", frame.humidity_percentage);
+        }
+        
+        /* sampler stop */
+        a_sampler_stop();
+        
+        return 0;
+    }
+    else if (strcmp("e_stream", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t lost;
+        uint8_t stop[8];
+        uint8_t buf[BME680_SAMPLER_FRAME_LEN];
+        bme680_sampler_frame_t frame;
+        
+        /* sampler start */
+        res = a_sampler_start(interface, addr, period_us, interrupt);
+        if (res != 0)
+        {
+            return res;
+        }
+        
+        /* loop */
+        i = 0;
+        lost = 0;
+        while (i < times)
+        {
+            /* stop by any input */
+            if (uart_read(stop, 8) != 0)
+            {
+                break;
+            }
+            
+            /* run the bus transfers flagged by the irqs */
+            a_sampler_poll();
+            
+            /* pop one frame */
+            if (bme680_sampler_pop(&frame) != 0)
+            {
+                /* sleep until the next interrupt */
+                a_sampler_sleep();
+                
+                continue;
+            }
+            
+            /* queue the binary frame */
+            (void)bme680_sampler_pack(&frame, buf);
+            if (uart_enqueue(buf, BME680_SAMPLER_FRAME_LEN) != 0)
+            {
+                lost++;
+            }
+            else
+            {
+                i++;
+            }
+        }
+        
+        /* output */
+        bme680_interface_debug_print("\nbme680: sent %d frames, lost %d frames.\n", i, lost);
+        
+        /* sampler stop */
+        a_sampler_stop();
+        
+        return 0;
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -375,16 +789,22 @@ uint8_t bme680(uint8_t argc, char **argv)
         bme680_interface_debug_print("  bme680 (-e read | --example=read) [--addr=<0 | 1>] [--interface=<iic | spi>] [--times=<num>]\n");
         bme680_interface_debug_print("  bme680 (-e gas | --example=gas) [--addr=<0 | 1>] [--interface=<iic | spi>] [--index=<index>]\n");
         bme680_interface_debug_print("         [--degree=<degree>] [--wait=<ms>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e sampler | --example=sampler) [--addr=<0 | 1>] [--interface=<iic | spi>] [--period=<us>]\n");
+        bme680_interface_debug_print("         [--interrupt=<true | false>] [--times=<num>]\n");
+        bme680_interface_debug_print("  bme680 (-e stream | --example=stream) [--addr=<0 | 1>] [--interface=<iic | spi>] [--period=<us>]\n");
+        bme680_interface_debug_print("         [--interrupt=<true | false>] [--times=<num>]\n");
         bme680_interface_debug_print("\n");
         bme680_interface_debug_print("Options:\n");
         bme680_interface_debug_print("      --addr=<0 | 1>                 Set the chip iic address.([default: 0])\n");
         bme680_interface_debug_print("      --degree=<degree>              Set the heater expected temperature in degree celsius.([default: 200.0])\n");
-        bme680_interface_debug_print("  -e <read | gas>, --example=<read | gas>\n");
+        bme680_interface_debug_print("  -e <read | gas | sampler | stream>, --example=<read | gas | sampler | stream>\n");
         bme680_interface_debug_print("                                     Run the driver example.\n");
         bme680_interface_debug_print("  -h, --help                         Show the help.\n");
         bme680_interface_debug_print("  -i, --information                  Show the chip information.\n");
         bme680_interface_debug_print("      --index=<index>                Set the heater index and it range is 0 - 9.([default: 0])\n");
         bme680_interface_debug_print("      --interface=<iic | spi>        Set the chip interface.([default: iic])\n");
+        bme680_interface_debug_print("      --interrupt=<true | false>     Set the sampler completed by the spi 3 wire data ready interrupt.([default: false])\n");
+        bme680_interface_debug_print("      --period=<us>                  Set the sampler timer period in us.([default: 1000000])\n");
         bme680_interface_debug_print("  -p, --port                         Display the pin connections of the current board.\n");
         bme680_interface_debug_print("  -t <reg | read>, --test=<reg | read>\n");
         bme680_interface_debug_print("                                     Run the driver test.\n");
@@ -415,7 +835,7 @@ uint8_t bme680(uint8_t argc, char **argv)
     {
         /* print pin connection */
         bme680_interface_debug_print("bme680: SPI interface SCK connected to GPIOA PIN5.\n");
-        bme680_interface_debug_print("bme680: SPI interface MISO connected to GPIOA PIN6.\n");
+        bme680_interface_debug_print("bme680: SPI interface MISO(INT in 3 wire mode) connected to GPIOA PIN6.\n");
         bme680_interface_debug_print("bme680: SPI interface MOSI connected to GPIOA PIN7.\n");
         bme680_interface_debug_print("bme680: SPI interface CS connected to GPIOA PIN4.\n");
         bme680_interface_debug_print("bme680: SCL connected to GPIOB PIN8.\n");
@@ -489,6 +909,8 @@ int main(void)
             }
             uart_flush();
         }
-        delay_ms(100);
+        
+        /* sleep until the next interrupt */
+        __WFI();
     }
 }
@@ -35,6 +35,7 @@
  */
 
 #include "stm32f4xx_hal.h"
+#include "uart.h"
 
 /** 
  * @defgroup msp HAL_MSP_Private_Functions
@@ -67,6 +68,7 @@ void HAL_MspDeInit(void)
 void HAL_UART_MspInit(UART_HandleTypeDef *huart)
 {
     GPIO_InitTypeDef GPIO_InitStruct;
+    DMA_HandleTypeDef *hdma;
     
     if (huart->Instance == USART1)
     {
@@ -87,6 +89,45 @@ void HAL_UART_MspInit(UART_HandleTypeDef *huart)
         GPIO_InitStruct.Alternate = GPIO_AF7_USART1;
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
         
+        /* enable dma2 clock */
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        
+        /* DMA2 stream7 channel4 ------> USART1_TX */
+        hdma = uart_get_dma_tx_handle();
+        hdma->Instance = DMA2_Stream7;
+        hdma->Init.Channel = DMA_CHANNEL_4;
+        hdma->Init.Direction = DMA_MEMORY_TO_PERIPH;
+        hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+        hdma->Init.MemInc = DMA_MINC_ENABLE;
+        hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        hdma->Init.Mode = DMA_NORMAL;
+        hdma->Init.Priority = DMA_PRIORITY_LOW;
+        hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        (void)HAL_DMA_Init(hdma);
+        __HAL_LINKDMA(huart, hdmatx, *hdma);
+        
+        /* DMA2 stream2 channel4 ------> USART1_RX */
+        hdma = uart_get_dma_rx_handle();
+        hdma->Instance = DMA2_Stream2;
+        hdma->Init.Channel = DMA_CHANNEL_4;
+        hdma->Init.Direction = DMA_PERIPH_TO_MEMORY;
+        hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+        hdma->Init.MemInc = DMA_MINC_ENABLE;
+        hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        hdma->Init.Mode = DMA_CIRCULAR;
+        hdma->Init.Priority = DMA_PRIORITY_MEDIUM;
+        hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        (void)HAL_DMA_Init(hdma);
+        __HAL_LINKDMA(huart, hdmarx, *hdma);
+        
+        /* enable dma nvic */
+        HAL_NVIC_SetPriority(DMA2_Stream7_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+        HAL_NVIC_SetPriority(DMA2_Stream2_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(DMA2_Stream2_IRQn);
+        
         /* enable nvic */
         HAL_NVIC_SetPriority(USART1_IRQn, 1, 0);
         HAL_NVIC_EnableIRQ(USART1_IRQn);
@@ -131,6 +172,12 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* huart)
         /* uart gpio deinit */
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_9 | GPIO_PIN_10);
         
+        /* dma deinit */
+        (void)HAL_DMA_DeInit(huart->hdmatx);
+        (void)HAL_DMA_DeInit(huart->hdmarx);
+        HAL_NVIC_DisableIRQ(DMA2_Stream7_IRQn);
+        HAL_NVIC_DisableIRQ(DMA2_Stream2_IRQn);
+        
         /* disable nvic */
         HAL_NVIC_DisableIRQ(USART1_IRQn);
     }
@@ -195,6 +242,58 @@ void HAL_SPI_MspDeInit(SPI_HandleTypeDef* hspi)
     }
 }
 
+/**
+ * @brief     tim base hal init
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM2)
+    {
+        /* enable tim2 clock */
+        __HAL_RCC_TIM2_CLK_ENABLE();
+        
+        /* enable nvic */
+        HAL_NVIC_SetPriority(TIM2_IRQn, 3, 0);
+        HAL_NVIC_EnableIRQ(TIM2_IRQn);
+    }
+    if (htim->Instance == TIM5)
+    {
+        /* enable tim5 clock */
+        __HAL_RCC_TIM5_CLK_ENABLE();
+        
+        /* enable nvic */
+        HAL_NVIC_SetPriority(TIM5_IRQn, 3, 0);
+        HAL_NVIC_EnableIRQ(TIM5_IRQn);
+    }
+}
+
+/**
+ * @brief     tim base hal deinit
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_Base_MspDeInit(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM2)
+    {
+        /* disable tim2 clock */
+        __HAL_RCC_TIM2_CLK_DISABLE();
+        
+        /* disable nvic */
+        HAL_NVIC_DisableIRQ(TIM2_IRQn);
+    }
+    if (htim->Instance == TIM5)
+    {
+        /* disable tim5 clock */
+        __HAL_RCC_TIM5_CLK_DISABLE();
+        
+        /* disable nvic */
+        HAL_NVIC_DisableIRQ(TIM5_IRQn);
+    }
+}
+
 /**
  * @}
  */
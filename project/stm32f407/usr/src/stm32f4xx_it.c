@@ -36,6 +36,8 @@
 
 #include "stm32f4xx_it.h"
 #include "uart.h"
+#include "tim.h"
+#include "gpio.h"
 
 /**
  * @brief nmi handler
@@ -164,6 +166,24 @@ void USART2_IRQHandler(void)
     HAL_UART_IRQHandler(uart2_get_handle());
 }
 
+/**
+ * @brief dma2 stream2 irq handler
+ * @note  none
+ */
+void DMA2_Stream2_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(uart_get_dma_rx_handle());
+}
+
+/**
+ * @brief dma2 stream7 irq handler
+ * @note  none
+ */
+void DMA2_Stream7_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(uart_get_dma_tx_handle());
+}
+
 /**
  * @brief     uart error callback
  * @param[in] *huart pointer to a uart handle
@@ -172,6 +192,11 @@ void USART2_IRQHandler(void)
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
     __HAL_UART_CLEAR_FEFLAG(huart);
+    if (huart->Instance == USART1)
+    {
+        /* run the uart error irq handler */
+        uart_error_irq_handler();
+    }
 }
 
 /**
@@ -181,11 +206,6 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
  */
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {    
-    if (huart->Instance == USART1)
-    {
-        /* run the uart irq handler */
-        uart_irq_handler();
-    }
     if (huart->Instance == USART2)
     {
         /* run the uart2 irq handler */
@@ -193,6 +213,21 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
     }
 }
 
+/**
+ * @brief     uart rx event callback
+ * @param[in] *huart pointer to a uart handle
+ * @param[in] size dma rx buffer position
+ * @note      none
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size)
+{
+    if (huart->Instance == USART1)
+    {
+        /* run the uart rx event irq handler */
+        uart_rx_event_irq_handler(size);
+    }
+}
+
 /**
  * @brief     uart tx finished callback
  * @param[in] *huart pointer to a uart handle
@@ -202,8 +237,8 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
     if (huart->Instance == USART1)
     {
-        /* set tx done */
-        uart_set_tx_done();
+        /* run the uart tx irq handler */
+        uart_tx_irq_handler();
     }
     if (huart->Instance == USART2)
     {
@@ -211,3 +246,63 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
         uart2_set_tx_done();
     }
 }
+
+/**
+ * @brief tim2 irq handler
+ * @note  none
+ */
+void TIM2_IRQHandler(void)
+{
+    HAL_TIM_IRQHandler(tim_get_handle());
+}
+
+/**
+ * @brief tim5 irq handler
+ * @note  none
+ */
+void TIM5_IRQHandler(void)
+{
+    HAL_TIM_IRQHandler(tim_oneshot_get_handle());
+}
+
+/**
+ * @brief     tim period elapsed callback
+ * @param[in] *htim pointer to a tim handle
+ * @note      none
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM2)
+    {
+        /* run the tim irq handler */
+        tim_irq_handler();
+    }
+    if (htim->Instance == TIM5)
+    {
+        /* run the tim oneshot irq handler */
+        tim_oneshot_irq_handler();
+    }
+}
+
+/**
+ * @brief exti9_5 irq handler
+ * @note  none
+ */
+void EXTI9_5_IRQHandler(void)
+{
+    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_6);
+}
+
+/**
+ * @brief     gpio exti callback
+ * @param[in] pin gpio pin
+ * @note      none
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t pin)
+{
+    if (pin == GPIO_PIN_6)
+    {
+        /* run the gpio irq handler */
+        gpio_irq_handler();
+    }
+}
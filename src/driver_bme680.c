@@ -111,6 +111,20 @@
 #define BME680_REG_PRESS_MSB           0x1F        /**< press msb register */
 #define BME680_REG_MEAS_STATUS         0x1D        /**< meas status register */
 
+/**
+ * @brief sample cache flag definition
+ */
+#define BME680_CACHE_TEMPERATURE       (1 << 0)    /**< temperature is cached */
+#define BME680_CACHE_PRESSURE          (1 << 1)    /**< pressure is cached */
+#define BME680_CACHE_HUMIDITY          (1 << 2)    /**< humidity is cached */
+#define BME680_CACHE_ALL               0x07        /**< all are cached */
+
+/**
+ * @brief configuration cache definition
+ */
+#define BME680_CONFIG_START            0x50        /**< first cached register */
+#define BME680_CONFIG_LEN              38          /**< cached registers from 0x50 to 0x75 */
+
 /**
  * @brief     change spi page
  * @param[in] *handle pointer to a bme680 handle structure
@@ -150,7 +164,7 @@ static uint8_t a_bme680_change_spi_page(bme680_handle_t *handle, uint8_t page)
 }
 
 /**
- * @brief      read multiple bytes
+ * @brief      read multiple bytes in one transaction
  * @param[in]  *handle pointer to a bme680 handle structure
  * @param[in]  reg register address
  * @param[out] *buf pointer to a data buffer
@@ -160,7 +174,7 @@ static uint8_t a_bme680_change_spi_page(bme680_handle_t *handle, uint8_t page)
  *             - 1 iic spi read failed
  * @note       none
  */
-static uint8_t a_bme680_iic_spi_read(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+static uint8_t a_bme680_iic_spi_read_once(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
     if (handle->iic_spi == BME680_INTERFACE_IIC)                           /* iic interface */
     {
@@ -210,7 +224,33 @@ static uint8_t a_bme680_iic_spi_read(bme680_handle_t *handle, uint8_t reg, uint8
 }
 
 /**
- * @brief     write multiple bytes
+ * @brief     update the configuration cache after a register write
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @note      a burst write is a list of register pairs, the first register is reg and
+ *            the next ones are at the odd offsets of buf, so every pair is saved
+ */
+static void a_bme680_config_cache_update(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+
+    for (i = 0; i < len; i += 2)                                                                /* run all pairs */
+    {
+        if (i != 0)                                                                             /* check the first pair */
+        {
+            reg = buf[i - 1];                                                                   /* get the next register */
+        }
+        if ((reg >= BME680_CONFIG_START) && (reg < BME680_CONFIG_START + BME680_CONFIG_LEN))    /* check range */
+        {
+            handle->config_cache[reg - BME680_CONFIG_START] = buf[i];                           /* save the value */
+        }
+    }
+}
+
+/**
+ * @brief     write multiple bytes in one transaction
  * @param[in] *handle pointer to a bme680 handle structure
  * @param[in] reg register address
  * @param[in] *buf pointer to a data buffer
@@ -220,7 +260,7 @@ static uint8_t a_bme680_iic_spi_read(bme680_handle_t *handle, uint8_t reg, uint8
  *            - 1 iic spi write failed
  * @note      none
  */
-static uint8_t a_bme680_iic_spi_write(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+static uint8_t a_bme680_iic_spi_write_once(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
     if (handle->iic_spi == BME680_INTERFACE_IIC)                           /* iic interface */
     {
@@ -228,6 +268,7 @@ static uint8_t a_bme680_iic_spi_write(bme680_handle_t *handle, uint8_t reg, uint
         {
             return 1;                                                      /* return error */
         }
+        a_bme680_config_cache_update(handle, reg, buf, len);               /* update the cache */
 
         return 0;                                                          /* success return 0 */
     }
@@ -263,12 +304,443 @@ static uint8_t a_bme680_iic_spi_write(bme680_handle_t *handle, uint8_t reg, uint
             {
                 return 1;                                                  /* return error */
             }
+            a_bme680_config_cache_update(handle, reg, buf, len);           /* update the cache */
         }
 
         return 0;                                                          /* success return 0 */
     }
 }
 
+/**
+ * @brief     wait before the next attempt of a failed transaction
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] attempt failed attempt number
+ * @return    status code
+ *            - 0 retry
+ *            - 1 give up
+ * @note      the backoff doubles after every attempt
+ */
+static uint8_t a_bme680_retry_wait(bme680_handle_t *handle, uint8_t attempt)
+{
+    uint64_t backoff_ms;
+    uint64_t total_ms;
+
+    if (attempt > handle->retry_times)                                                 /* check attempts */
+    {
+        handle->retry_failed++;                                                        /* count the failure */
+
+        return 1;                                                                      /* give up */
+    }
+    backoff_ms = (uint64_t)handle->retry_backoff_ms << (attempt - 1);                  /* get this backoff */
+    total_ms = (backoff_ms << 1) - handle->retry_backoff_ms;                           /* get the total backoff */
+    if ((handle->retry_budget_ms != 0) && (total_ms > handle->retry_budget_ms))        /* check budget */
+    {
+        handle->retry_failed++;                                                        /* count the failure */
+
+        return 1;                                                                      /* give up */
+    }
+    if (backoff_ms != 0)                                                               /* check backoff */
+    {
+        handle->delay_ms((uint32_t)backoff_ms);                                        /* wait the backoff */
+    }
+    handle->retry_count++;                                                             /* count the retry */
+
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      read multiple bytes with the retry policy
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 iic spi read failed
+ * @note       none
+ */
+static uint8_t a_bme680_iic_spi_read(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t attempt;
+
+    for (attempt = 1; ; attempt++)                                         /* run all attempts */
+    {
+        if (a_bme680_iic_spi_read_once(handle, reg, buf, len) == 0)        /* read once */
+        {
+            return 0;                                                      /* success return 0 */
+        }
+        if (a_bme680_retry_wait(handle, attempt) != 0)                     /* wait before the retry */
+        {
+            return 1;                                                      /* return error */
+        }
+    }
+}
+
+/**
+ * @brief     write multiple bytes with the retry policy
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic spi write failed
+ * @note      register writes are idempotent, so a write whose ack was lost is safe to repeat
+ */
+static uint8_t a_bme680_iic_spi_write(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t attempt;
+
+    for (attempt = 1; ; attempt++)                                          /* run all attempts */
+    {
+        if (a_bme680_iic_spi_write_once(handle, reg, buf, len) == 0)        /* write once */
+        {
+            return 0;                                                       /* success return 0 */
+        }
+        if (a_bme680_retry_wait(handle, attempt) != 0)                      /* wait before the retry */
+        {
+            return 1;                                                       /* return error */
+        }
+    }
+}
+
+/**
+ * @brief     write a list of register pairs in one transfer
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] *buf pointer to a register and value pair buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write pairs failed
+ * @note      all registers must be below 0x80
+ */
+static uint8_t a_bme680_write_pairs(bme680_handle_t *handle, uint8_t *buf, uint16_t len)
+{
+    if (handle->iic_spi == BME680_INTERFACE_IIC)                                       /* iic interface */
+    {
+        if (handle->iic_write(handle->iic_addr, buf[0], &buf[1], len - 1) != 0)        /* iic write */
+        {
+            return 1;                                                                  /* return error */
+        }
+    }
+    else                                                                               /* spi interface */
+    {
+        if (handle->page == 0)                                                         /* check page */
+        {
+            if (a_bme680_change_spi_page(handle, 1) != 0)                              /* change spi page 1 */
+            {
+                return 1;                                                              /* return error */
+            }
+        }
+        if (handle->spi_write(buf[0], &buf[1], len - 1) != 0)                          /* spi write */
+        {
+            return 1;                                                                  /* return error */
+        }
+    }
+
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     load the configuration cache from the chip
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 load failed
+ * @note      none
+ */
+static uint8_t a_bme680_config_cache_load(bme680_handle_t *handle)
+{
+    handle->config_valid = 0;                                                                                    /* clear the flag */
+    if (a_bme680_iic_spi_read(handle, BME680_CONFIG_START, handle->config_cache, BME680_CONFIG_LEN) != 0)        /* read the registers */
+    {
+        handle->debug_print("bme680: load configuration failed.\n");                                             /* load configuration failed */
+
+        return 1;                                                                                                /* return error */
+    }
+    handle->config_valid = 1;                                                                                    /* set the flag */
+
+    return 0;                                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      read one configuration register
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  reg register address
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the configuration cache is used when it is valid
+ */
+static uint8_t a_bme680_config_read(bme680_handle_t *handle, uint8_t reg, uint8_t *value)
+{
+    if ((handle->config_valid == 1) && (reg >= BME680_CONFIG_START) &&
+        (reg < BME680_CONFIG_START + BME680_CONFIG_LEN))                 /* check the cache */
+    {
+        *value = handle->config_cache[reg - BME680_CONFIG_START];        /* get the cached value */
+
+        return 0;                                                        /* success return 0 */
+    }
+    if (a_bme680_iic_spi_read(handle, reg, value, 1) != 0)               /* read the register */
+    {
+        return 1;                                                        /* return error */
+    }
+
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      calculate the expected duration of one forced conversion
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *us pointer to a duration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 calculate failed
+ * @note       none
+ */
+static uint8_t a_bme680_measurement_duration(bme680_handle_t *handle, uint32_t *us)
+{
+    const uint8_t cycles[8] = {0, 1, 2, 4, 8, 16, 16, 16};
+    const uint8_t factor[4] = {1, 4, 16, 64};
+    uint8_t ctrl_meas;
+    uint8_t ctrl_hum;
+    uint8_t ctrl_gas_1;
+    uint8_t gas_wait;
+    uint32_t meas_cycles;
+    uint32_t duration;
+
+    if (a_bme680_config_read(handle, BME680_REG_CTRL_MEAS, &ctrl_meas) != 0)                                  /* read ctrl meas */
+    {
+        handle->debug_print("bme680: read ctrl meas failed.\n");                                              /* read ctrl meas failed */
+
+        return 1;                                                                                             /* return error */
+    }
+    if (a_bme680_config_read(handle, BME680_REG_CTRL_HUM, &ctrl_hum) != 0)                                    /* read ctrl hum */
+    {
+        handle->debug_print("bme680: read ctrl hum failed.\n");                                               /* read ctrl hum failed */
+
+        return 1;                                                                                             /* return error */
+    }
+    if (a_bme680_config_read(handle, BME680_REG_CTRL_GAS_1, &ctrl_gas_1) != 0)                                /* read ctrl gas1 */
+    {
+        handle->debug_print("bme680: read ctrl gas1 failed.\n");                                              /* read ctrl gas1 failed */
+
+        return 1;                                                                                             /* return error */
+    }
+    meas_cycles = cycles[(ctrl_meas >> 5) & 0x07];                                                            /* temperature cycles */
+    meas_cycles += cycles[(ctrl_meas >> 2) & 0x07];                                                           /* pressure cycles */
+    meas_cycles += cycles[(ctrl_hum >> 0) & 0x07];                                                            /* humidity cycles */
+    duration = meas_cycles * 1963;                                                                            /* oversampling time */
+    duration += 477 * 4;                                                                                      /* tph switching time */
+    duration += 477 * 5;                                                                                      /* gas measurement time */
+    duration += 1000;                                                                                         /* wake up time */
+    if (((ctrl_gas_1 >> 4) & 0x01) != 0)                                                                      /* if run gas */
+    {
+        if ((ctrl_gas_1 & 0x0F) > 9)                                                                          /* check index */
+        {
+            handle->debug_print("bme680: index > 9.\n");                                                      /* index > 9 */
+
+            return 1;                                                                                         /* return error */
+        }
+        if (a_bme680_config_read(handle, BME680_REG_GAS_WAIT_X + (ctrl_gas_1 & 0x0F), &gas_wait) != 0)        /* read gas wait */
+        {
+            handle->debug_print("bme680: read gas wait failed.\n");                                           /* read gas wait failed */
+
+            return 1;                                                                                         /* return error */
+        }
+        duration += (uint32_t)(gas_wait & 0x3F) * factor[(gas_wait >> 6) & 0x03] * 1000;                      /* heater duration */
+    }
+    *us = duration;                                                                                           /* set duration */
+
+    return 0;                                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     get the polling timeout of one conversion
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    timeout in ms
+ * @note      a zero margin keeps the fixed 10s timeout, which is also the fallback when the duration is unknown
+ */
+static uint32_t a_bme680_conversion_timeout(bme680_handle_t *handle)
+{
+    uint32_t us;
+
+    if (handle->timeout_margin_ms == 0)                          /* check margin */
+    {
+        return 10 * 1000;                                        /* fixed timeout */
+    }
+    if (a_bme680_measurement_duration(handle, &us) != 0)         /* get the expected duration */
+    {
+        return 10 * 1000;                                        /* fixed timeout */
+    }
+
+    return (us + 999) / 1000 + handle->timeout_margin_ms;        /* duration and margin */
+}
+
+/**
+ * @brief     lock the shared bus
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus lock failed
+ * @note      none
+ */
+static uint8_t a_bme680_bus_lock(bme680_handle_t *handle)
+{
+    if (handle->bus_lock == NULL)                             /* check bus_lock */
+    {
+        return 0;                                             /* no bus locking */
+    }
+    if (handle->bus_lock(handle) != 0)                        /* lock the bus */
+    {
+        handle->debug_print("bme680: bus lock failed.\n");     /* bus lock failed */
+
+        return 1;                                             /* return error */
+    }
+
+    return 0;                                                 /* success return 0 */
+}
+
+/**
+ * @brief     unlock the shared bus
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus unlock failed
+ * @note      none
+ */
+static uint8_t a_bme680_bus_unlock(bme680_handle_t *handle)
+{
+    if (handle->bus_unlock == NULL)                           /* check bus_unlock */
+    {
+        return 0;                                             /* no bus locking */
+    }
+    if (handle->bus_unlock(handle) != 0)                      /* unlock the bus */
+    {
+        handle->debug_print("bme680: bus unlock failed.\n");   /* bus unlock failed */
+
+        return 1;                                             /* return error */
+    }
+
+    return 0;                                                 /* success return 0 */
+}
+
+/**
+ * @brief     close the bus of the chip interface
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus deinit failed
+ * @note      none
+ */
+static uint8_t a_bme680_bus_deinit(bme680_handle_t *handle)
+{
+    if (handle->iic_spi == BME680_INTERFACE_IIC)              /* iic interface */
+    {
+        return handle->iic_deinit();                          /* iic deinit */
+    }
+    else                                                      /* spi interface */
+    {
+        return handle->spi_deinit();                          /* spi deinit */
+    }
+}
+
+/**
+ * @brief     check the sample cache
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] flag cache flag
+ * @return    status code
+ *            - 0 cache is missed
+ *            - 1 cache is hit
+ * @note      none
+ */
+static uint8_t a_bme680_cache_check(bme680_handle_t *handle, uint8_t flag)
+{
+    if ((handle->cache_max_age_ms == 0) || (handle->get_time_ms == NULL))             /* check cache enable */
+    {
+        return 0;                                                                     /* cache is disabled */
+    }
+    if ((handle->cache_valid & flag) != flag)                                         /* check cache valid */
+    {
+        return 0;                                                                     /* not cached */
+    }
+    if ((uint32_t)(handle->get_time_ms() - handle->cache_time_ms) >
+        handle->cache_max_age_ms)                                                     /* check cache age */
+    {
+        return 0;                                                                     /* too old */
+    }
+
+    return 1;                                                                         /* cache is hit */
+}
+
+/**
+ * @brief     save the sample cache
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] flag cache flag
+ * @note      the cache values of the flag must be set before,
+ *            the flags of the older sample are dropped so all cached values are from one conversion
+ */
+static void a_bme680_cache_save(bme680_handle_t *handle, uint8_t flag)
+{
+    if ((handle->cache_max_age_ms == 0) || (handle->get_time_ms == NULL))             /* check cache enable */
+    {
+        return;                                                                       /* cache is disabled */
+    }
+    handle->cache_time_ms = handle->get_time_ms();                                    /* save sample time */
+    handle->cache_valid = flag;                                                       /* set cache valid */
+}
+
+/**
+ * @brief     get the checksum of the calibration coefficients
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    fletcher-16 checksum
+ * @note      none
+ */
+static uint16_t a_bme680_calibration_checksum(bme680_handle_t *handle)
+{
+    uint8_t i;
+    uint16_t sum1;
+    uint16_t sum2;
+    uint16_t value[26];
+
+    value[0] = (uint16_t)handle->par_h1;                                   /* set par h1 */
+    value[1] = (uint16_t)handle->par_h2;                                   /* set par h2 */
+    value[2] = (uint16_t)handle->par_h3;                                   /* set par h3 */
+    value[3] = (uint16_t)handle->par_h4;                                   /* set par h4 */
+    value[4] = (uint16_t)handle->par_h5;                                   /* set par h5 */
+    value[5] = (uint16_t)handle->par_h6;                                   /* set par h6 */
+    value[6] = (uint16_t)handle->par_h7;                                   /* set par h7 */
+    value[7] = (uint16_t)handle->par_gh1;                                  /* set par gh1 */
+    value[8] = (uint16_t)handle->par_gh2;                                  /* set par gh2 */
+    value[9] = (uint16_t)handle->par_gh3;                                  /* set par gh3 */
+    value[10] = (uint16_t)handle->par_t1;                                  /* set par t1 */
+    value[11] = (uint16_t)handle->par_t2;                                  /* set par t2 */
+    value[12] = (uint16_t)handle->par_t3;                                  /* set par t3 */
+    value[13] = (uint16_t)handle->par_p1;                                  /* set par p1 */
+    value[14] = (uint16_t)handle->par_p2;                                  /* set par p2 */
+    value[15] = (uint16_t)handle->par_p3;                                  /* set par p3 */
+    value[16] = (uint16_t)handle->par_p4;                                  /* set par p4 */
+    value[17] = (uint16_t)handle->par_p5;                                  /* set par p5 */
+    value[18] = (uint16_t)handle->par_p6;                                  /* set par p6 */
+    value[19] = (uint16_t)handle->par_p7;                                  /* set par p7 */
+    value[20] = (uint16_t)handle->par_p8;                                  /* set par p8 */
+    value[21] = (uint16_t)handle->par_p9;                                  /* set par p9 */
+    value[22] = (uint16_t)handle->par_p10;                                 /* set par p10 */
+    value[23] = (uint16_t)handle->res_heat_range;                          /* set res heat range */
+    value[24] = (uint16_t)handle->res_heat_val;                            /* set res heat val */
+    value[25] = (uint16_t)handle->range_sw_err;                            /* set range sw err */
+    sum1 = 0;                                                              /* init sum1 */
+    sum2 = 0;                                                              /* init sum2 */
+    for (i = 0; i < 26; i++)                                               /* run all coefficients */
+    {
+        sum1 = (sum1 + (value[i] & 0xFF) + (value[i] >> 8)) % 255;        /* add the value */
+        sum2 = (sum2 + sum1) % 255;                                       /* add the sum */
+    }
+
+    return (uint16_t)((sum2 << 8) | sum1);                                 /* return the checksum */
+}
+
 /**
  * @brief     get nvm calibration
  * @param[in] *handle pointer to a bme680 handle structure
@@ -466,6 +938,7 @@ static uint8_t a_bme680_get_nvm_calibration(bme680_handle_t *handle)
     handle->range_sw_err = (int8_t)((reg >> 4) & 0xF);                                         /* set range switch error */
     handle->t_fine = 0.0f;                                                                     /* init 0 */
     handle->amb_temp = 25;                                                                     /* set 25c */
+    handle->calibration_checksum = a_bme680_calibration_checksum(handle);                      /* save checksum */
 
     return 0;                                                                                  /* success return 0 */
 }
@@ -618,16 +1091,67 @@ static uint8_t a_bme680_compensate_heat(bme680_handle_t *handle, float temp, uin
 }
 
 /**
- * @brief      compensate gas resistance
- * @param[in]  *handle pointer to a bme680 handle structure
- * @param[in]  gas_res_adc gas resistance adc
- * @param[in]  gas_range gas range
- * @param[out] *ohms pointer to an ohms buffer
- * @return     status code
- *             - 0 success
- *             - 1 compensate gas resistance failed
- * @note       none
- */
+ * @brief     feed the compensated temperature back to the ambient temperature
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] temperature_c compensated temperature
+ * @return    status code
+ *            - 0 success
+ *            - 1 ambient feedback failed
+ * @note      the caller must hold the bus
+ */
+static uint8_t a_bme680_ambient_feedback(bme680_handle_t *handle, float temperature_c)
+{
+    uint8_t i;
+    uint8_t reg;
+    float drift;
+
+    if (handle->amb_threshold == 0)                                                                                /* check feedback */
+    {
+        return 0;                                                                                                  /* feedback is disabled */
+    }
+    drift = temperature_c - (float)handle->amb_temp;                                                               /* get drift */
+    if ((drift < (float)handle->amb_threshold) && (drift > -(float)handle->amb_threshold))                         /* check threshold */
+    {
+        return 0;                                                                                                  /* drift is small */
+    }
+    if (temperature_c > 127.0f)                                                                                    /* check max */
+    {
+        temperature_c = 127.0f;                                                                                    /* set max */
+    }
+    if (temperature_c < -128.0f)                                                                                   /* check min */
+    {
+        temperature_c = -128.0f;                                                                                   /* set min */
+    }
+    handle->amb_temp = (int8_t)((temperature_c >= 0.0f) ? (temperature_c + 0.5f) : (temperature_c - 0.5f));        /* round to degree c */
+    for (i = 0; i < 10; i++)                                                                                       /* recompute all targets */
+    {
+        if ((handle->heat_target_mask & (1 << i)) == 0)                                                            /* check target */
+        {
+            continue;                                                                                              /* skip unset index */
+        }
+        (void)a_bme680_compensate_heat(handle, handle->heat_target_c[i], &reg);                                    /* recompute register */
+        if (a_bme680_iic_spi_write(handle, BME680_REG_RES_HEAT_X + i, &reg, 1) != 0)                               /* write resistance heater */
+        {
+            handle->debug_print("bme680: write resistance heater failed.\n");                                      /* write resistance heater failed */
+
+            return 1;                                                                                              /* return error */
+        }
+    }
+
+    return 0;                                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      compensate gas resistance
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  gas_res_adc gas resistance adc
+ * @param[in]  gas_range gas range
+ * @param[out] *ohms pointer to an ohms buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 compensate gas resistance failed
+ * @note       none
+ */
 static uint8_t a_bme680_compensate_gas_resistance(bme680_handle_t *handle, uint16_t gas_res_adc, uint8_t gas_range, float *ohms)
 {
     float calc_gas_res;
@@ -655,6 +1179,185 @@ static uint8_t a_bme680_compensate_gas_resistance(bme680_handle_t *handle, uint1
     return 0;                                                                  /* success return 0 */
 }
 
+/**
+ * @brief      run one forced conversion and read the selected outputs
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  mask output mask
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 compensate failed
+ *             - 5 read timeout
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ * @note       the caller locks the bus
+ */
+static uint8_t a_bme680_read_sample(bme680_handle_t *handle, uint8_t mask, bme680_sample_t *sample)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t len;
+    uint8_t flag;
+    uint32_t timeout;
+    uint8_t buf[8];
+
+    sample->mask = 0;                                                                                           /* clear valid outputs */
+    sample->status = 0;                                                                                         /* clear status */
+    if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                                     /* read ctrl meas */
+    {
+        handle->debug_print("bme680: read ctrl meas failed.\n");                                                /* read ctrl meas failed */
+
+        return 1;                                                                                               /* return error */
+    }
+    prev &= ~(3 << 0);                                                                                          /* clear settings */
+    prev |= 0x01 << 0;                                                                                          /* set forced mode */
+    if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                                    /* write ctrl meas */
+    {
+        handle->debug_print("bme680: write ctrl meas failed.\n");                                               /* write ctrl meas failed */
+
+        return 1;                                                                                               /* return error */
+    }
+    timeout = a_bme680_conversion_timeout(handle);                                                              /* set timeout */
+    while (timeout != 0)                                                                                        /* check timeout */
+    {
+        if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                                 /* read ctrl meas */
+        {
+            handle->debug_print("bme680: read ctrl meas failed.\n");                                            /* read ctrl meas failed */
+
+            return 1;                                                                                           /* return error */
+        }
+        if ((prev & 0x03) == 0)                                                                                 /* if finished */
+        {
+            break;                                                                                              /* break */
+        }
+        handle->delay_ms(1);                                                                                    /* delay 1ms */
+        timeout--;                                                                                              /* timeout-- */
+    }
+    if (timeout == 0)                                                                                           /* check timeout */
+    {
+        handle->debug_print("bme680: read timeout.\n");                                                         /* read timeout */
+
+        return 5;                                                                                               /* return error */
+    }
+    sample->timestamp_ms = (handle->get_time_ms != NULL) ? handle->get_time_ms() : 0;                           /* set timestamp */
+    flag = 0;                                                                                                   /* init cache flag */
+    if ((mask & (BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY)) != 0)            /* temperature pressure or humidity */
+    {
+        len = ((mask & BME680_OUTPUT_HUMIDITY) != 0) ? 8 : 6;                                                   /* skip humidity registers */
+        res = a_bme680_iic_spi_read(handle, BME680_REG_PRESS_MSB, buf, len);                                    /* read temperature pressure and humidity */
+        if (res != 0)
+        {
+            handle->debug_print("bme680: read failed.\n");                                                      /* read failed */
+
+            return 1;                                                                                           /* return error */
+        }
+        sample->temperature_raw = ((((uint32_t)(buf[3])) << 12) |
+                                  (((uint32_t)(buf[4])) << 4) |
+                                  ((uint32_t)buf[5] >> 4));                                                     /* set temperature raw */
+        res = a_bme680_compensate_temperature(handle, sample->temperature_raw, &sample->temperature_c);         /* compensate temperature */
+        if (res != 0)
+        {
+            handle->debug_print("bme680: compensate temperature failed.\n");                                    /* compensate temperature failed */
+
+            return 4;                                                                                           /* return error */
+        }
+        if (a_bme680_ambient_feedback(handle, sample->temperature_c) != 0)                                      /* ambient feedback */
+        {
+            return 1;                                                                                           /* return error */
+        }
+        handle->cache_temperature_raw = sample->temperature_raw;                                                /* save temperature raw */
+        handle->cache_temperature_c = sample->temperature_c;                                                    /* save temperature */
+        flag |= BME680_CACHE_TEMPERATURE;                                                                       /* temperature is cached */
+        sample->mask |= mask & BME680_OUTPUT_TEMPERATURE;                                                       /* temperature is valid */
+        if ((mask & BME680_OUTPUT_PRESSURE) != 0)                                                               /* check pressure */
+        {
+            sample->pressure_raw = ((((uint32_t)(buf[0])) << 12) |
+                                   (((uint32_t)(buf[1])) << 4) |
+                                   (((uint32_t)(buf[2])) >> 4));                                                /* set pressure raw */
+            res = a_bme680_compensate_pressure(handle, sample->pressure_raw, &sample->pressure_pa);             /* compensate pressure */
+            if (res != 0)
+            {
+                handle->debug_print("bme680: compensate pressure failed.\n");                                   /* compensate pressure failed */
+
+                return 4;                                                                                       /* return error */
+            }
+            handle->cache_pressure_raw = sample->pressure_raw;                                                  /* save pressure raw */
+            handle->cache_pressure_pa = sample->pressure_pa;                                                    /* save pressure */
+            flag |= BME680_CACHE_PRESSURE;                                                                      /* pressure is cached */
+            sample->mask |= BME680_OUTPUT_PRESSURE;                                                             /* pressure is valid */
+        }
+        if ((mask & BME680_OUTPUT_HUMIDITY) != 0)                                                               /* check humidity */
+        {
+            sample->humidity_raw = (uint32_t)buf[6] << 8 | buf[7];                                              /* set humidity raw */
+            res = a_bme680_compensate_humidity(handle, sample->humidity_raw, &sample->humidity_percentage);     /* compensate humidity */
+            if (res != 0)
+            {
+                handle->debug_print("bme680: compensate humidity failed.\n");                                   /* compensate humidity failed */
+
+                return 4;                                                                                       /* return error */
+            }
+            handle->cache_humidity_raw = sample->humidity_raw;                                                  /* save humidity raw */
+            handle->cache_humidity_percentage = sample->humidity_percentage;                                    /* save humidity */
+            flag |= BME680_CACHE_HUMIDITY;                                                                      /* humidity is cached */
+            sample->mask |= BME680_OUTPUT_HUMIDITY;                                                             /* humidity is valid */
+        }
+    }
+    if (flag != 0)                                                                                              /* check cache flag */
+    {
+        a_bme680_cache_save(handle, flag);                                                                      /* save the cache */
+    }
+    if ((mask & BME680_OUTPUT_GAS) != 0)                                                                        /* check gas */
+    {
+        res = a_bme680_iic_spi_read(handle, BME680_REG_GAS_R_MSB, buf, 2);                                      /* read gas */
+        if (res != 0)
+        {
+            handle->debug_print("bme680: read failed.\n");                                                      /* read failed */
+
+            return 1;                                                                                           /* return error */
+        }
+        if ((buf[1] & (1 << 5)) != 0)                                                                           /* check gas valid */
+        {
+            sample->status |= BME680_SAMPLE_STATUS_GAS_VALID;                                                   /* gas is valid */
+        }
+        if ((buf[1] & (1 << 4)) != 0)                                                                           /* check heat */
+        {
+            sample->status |= BME680_SAMPLE_STATUS_HEATER_STABLE;                                               /* heater is stable */
+        }
+        if ((sample->status & BME680_SAMPLE_STATUS_GAS_VALID) == 0)                                             /* check gas valid */
+        {
+            handle->debug_print("bme680: gas is invalid.\n");                                                   /* gas is invalid */
+
+            return 6;                                                                                           /* return error */
+        }
+        if ((sample->status & BME680_SAMPLE_STATUS_HEATER_STABLE) == 0)                                         /* check heat */
+        {
+            handle->debug_print("bme680: heater is not stable.\n");                                             /* heater is not stable */
+
+            return 7;                                                                                           /* return error */
+        }
+        sample->adc_raw = (((uint16_t)buf[0]) << 2) | ((buf[1] >> 6) & 0x03);                                   /* set adc raw */
+        sample->adc_range = buf[1] & 0x0F;                                                                      /* set adc range */
+        res = a_bme680_compensate_gas_resistance(handle, sample->adc_raw, sample->adc_range, &sample->ohms);    /* compensate gas resistance */
+        if (res != 0)                                                                                           /* check result */
+        {
+            handle->debug_print("bme680: compensate gas resistance failed.\n");                                 /* compensate gas resistance failed */
+
+            return 4;                                                                                           /* return error */
+        }
+        if (a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, &prev, 1) != 0)                               /* read status */
+        {
+            handle->debug_print("bme680: read status failed.\n");                                               /* read status failed */
+
+            return 1;                                                                                           /* return error */
+        }
+        sample->index = (prev & 0xF);                                                                           /* set index */
+        sample->mask |= BME680_OUTPUT_GAS;                                                                      /* gas is valid */
+    }
+
+    return 0;                                                                                                   /* success return 0 */
+}
+
 /**
  * @brief     set the iic address pin
  * @param[in] *handle pointer to a bme680 handle structure
@@ -740,7 +1443,7 @@ uint8_t bme680_get_interface(bme680_handle_t *handle, bme680_interface_t *interf
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     start the chip initialization
  * @param[in] *handle pointer to a bme680 handle structure
  * @return    status code
  *            - 0 success
@@ -748,11 +1451,11 @@ uint8_t bme680_get_interface(bme680_handle_t *handle, bme680_interface_t *interf
  *            - 2 handle is NULL
  *            - 3 linked functions is NULL
  *            - 4 id is error
- *            - 5 get nvm calibration failed
- *            - 6 read calibration failed
- * @note      none
+ *            - 5 reset failed
+ * @note      it checks the id and resets the chip without waiting for the reset,
+ *            call bme680_init_finish to complete the initialization
  */
-uint8_t bme680_init(bme680_handle_t *handle)
+uint8_t bme680_init_start(bme680_handle_t *handle)
 {
     uint8_t id;
     uint8_t reg;
@@ -820,11 +1523,16 @@ uint8_t bme680_init(bme680_handle_t *handle)
         return 3;                                                                    /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                              /* lock the bus */
+    {
+        return 1;                                                                    /* return error */
+    }
     if (handle->iic_spi == BME680_INTERFACE_IIC)                                     /* iic interface */
     {
         if (handle->iic_init() != 0)                                                 /* iic init */
         {
             handle->debug_print("bme680: iic init failed.\n");                       /* iic init failed */
+            (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
             return 1;                                                                /* return error */
         }
@@ -834,12 +1542,14 @@ uint8_t bme680_init(bme680_handle_t *handle)
         if (handle->spi_init() != 0)                                                 /* spi init */
         {
             handle->debug_print("bme680: spi init failed.\n");                       /* spi init failed */
+            (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
             return 1;                                                                /* return error */
         }
         if (a_bme680_change_spi_page(handle, 0) != 0)                                /* change spi page 0 */
         {
             handle->debug_print("bme680: change spi page failed.\n");                /* change spi page failed */
+            (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
             return 1;                                                                /* return error */
         }
@@ -848,14 +1558,16 @@ uint8_t bme680_init(bme680_handle_t *handle)
     if (a_bme680_iic_spi_read(handle, BME680_REG_ID, (uint8_t *)&id, 1) != 0)        /* read chip id */
     {
         handle->debug_print("bme680: read id failed.\n");                            /* read id failed */
-        (void)handle->iic_deinit();                                                  /* iic deinit */
+        (void)a_bme680_bus_deinit(handle);                                           /* bus deinit */
+        (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
         return 4;                                                                    /* return error */
     }
     if (id != 0x61)                                                                  /* check id */
     {
         handle->debug_print("bme680: id is error.\n");                               /* id is error */
-        (void)handle->iic_deinit();                                                  /* iic deinit */
+        (void)a_bme680_bus_deinit(handle);                                           /* bus deinit */
+        (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
         return 4;                                                                    /* return error */
     }
@@ -863,18 +1575,121 @@ uint8_t bme680_init(bme680_handle_t *handle)
     if (a_bme680_iic_spi_write(handle, BME680_REG_RESET, &reg, 1) != 0)              /* reset the chip */
     {
         handle->debug_print("bme680: reset failed.\n");                              /* reset failed */
-        (void)handle->iic_deinit();                                                  /* iic deinit */
+        (void)a_bme680_bus_deinit(handle);                                           /* bus deinit */
+        (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
         return 5;                                                                    /* return error */
     }
-    handle->delay_ms(5);                                                             /* delay 5ms */
+    handle->reset_time_ms = 0;                                                       /* clear reset time */
+    if (handle->get_time_ms != NULL)                                                 /* check get_time_ms */
+    {
+        handle->reset_time_ms = handle->get_time_ms();                               /* save reset time */
+    }
+    handle->inited = 2;                                                              /* flag reset pending */
+    (void)a_bme680_bus_unlock(handle);                                               /* unlock the bus */
+
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     finish the chip initialization
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus lock, get nvm calibration or configuration failed
+ *            - 2 handle is NULL
+ *            - 3 initialization is not started
+ * @note      it waits for the rest of the 5ms reset time and reads the calibration and the configuration,
+ *            the bus is closed if it fails
+ */
+uint8_t bme680_init_finish(bme680_handle_t *handle)
+{
+    uint32_t elapsed_ms;
+
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 2)                                                         /* check reset pending */
+    {
+        return 3;                                                                    /* return error */
+    }
+
+    if (handle->get_time_ms != NULL)                                                 /* check get_time_ms */
+    {
+        elapsed_ms = handle->get_time_ms() - handle->reset_time_ms;                  /* get elapsed time */
+        if (elapsed_ms < 6)                                                          /* one more tick for the resolution */
+        {
+            handle->delay_ms(6 - elapsed_ms);                                        /* wait the rest */
+        }
+    }
+    else                                                                             /* no timer */
+    {
+        handle->delay_ms(5);                                                         /* delay 5ms */
+    }
+    if (a_bme680_bus_lock(handle) != 0)                                              /* lock the bus */
+    {
+        (void)a_bme680_bus_deinit(handle);                                           /* bus deinit */
+        handle->inited = 0;                                                          /* flag close */
+
+        return 1;                                                                    /* return error */
+    }
     if (a_bme680_get_nvm_calibration(handle) != 0)                                   /* get nvm calibration */
     {
-        (void)handle->iic_deinit();                                                  /* iic deinit */
+        (void)a_bme680_bus_deinit(handle);                                           /* bus deinit */
+        handle->inited = 0;                                                          /* flag close */
+        (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
-        return 6;                                                                    /* return error */
+        return 1;                                                                    /* return error */
+    }
+    if (a_bme680_config_cache_load(handle) != 0)                                     /* load configuration */
+    {
+        (void)a_bme680_bus_deinit(handle);                                           /* bus deinit */
+        handle->inited = 0;                                                          /* flag close */
+        (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
+
+        return 1;                                                                    /* return error */
     }
+    handle->cache_valid = 0;                                                         /* clear the cache */
+    handle->continuous = 0;                                                          /* clear free running flag */
+    handle->amb_threshold = 0;                                                       /* disable ambient feedback */
+    handle->heat_target_mask = 0;                                                    /* clear heater targets */
+    handle->retry_times = 0;                                                         /* disable retry */
+    handle->retry_count = 0;                                                         /* clear retry counter */
+    handle->retry_failed = 0;                                                        /* clear failure counter */
+    handle->timeout_margin_ms = 0;                                                   /* fixed conversion timeout */
     handle->inited = 1;                                                              /* flag finish initialization */
+    (void)a_bme680_bus_unlock(handle);                                               /* unlock the bus */
+
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is error
+ *            - 5 get nvm calibration failed
+ *            - 6 read calibration failed
+ * @note      none
+ */
+uint8_t bme680_init(bme680_handle_t *handle)
+{
+    uint8_t res;
+
+    res = bme680_init_start(handle);                                                 /* check id and reset */
+    if (res != 0)                                                                    /* check result */
+    {
+        return res;                                                                  /* return error */
+    }
+    if (bme680_init_finish(handle) != 0)                                             /* read calibration */
+    {
+        return 6;                                                                    /* return error */
+    }
 
     return 0;                                                                        /* success return 0 */
 }
@@ -903,9 +1718,14 @@ uint8_t bme680_deinit(bme680_handle_t *handle)
         return 3;                                                                   /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                             /* lock the bus */
+    {
+        return 1;                                                                   /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)         /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");                    /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                          /* unlock the bus */
 
         return 4;                                                                   /* return error */
     }
@@ -914,6 +1734,7 @@ uint8_t bme680_deinit(bme680_handle_t *handle)
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)        /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");                   /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                          /* unlock the bus */
 
         return 4;                                                                   /* return error */
     }
@@ -922,6 +1743,7 @@ uint8_t bme680_deinit(bme680_handle_t *handle)
         if (handle->iic_deinit() != 0)                                              /* iic deinit */
         {
             handle->debug_print("bme680: iic deinit failed.\n");                    /* iic deinit failed */
+            (void)a_bme680_bus_unlock(handle);                                      /* unlock the bus */
 
             return 1;                                                               /* return error */
         }
@@ -931,11 +1753,13 @@ uint8_t bme680_deinit(bme680_handle_t *handle)
         if (handle->spi_deinit() != 0)                                              /* spi deinit */
         {
             handle->debug_print("bme680: spi deinit failed.\n");                    /* spi deinit failed */
+            (void)a_bme680_bus_unlock(handle);                                      /* unlock the bus */
 
             return 1;                                                               /* return error */
         }
     }
     handle->inited = 0;                                                             /* flag close */
+    (void)a_bme680_bus_unlock(handle);                                              /* unlock the bus */
 
     return 0;                                                                       /* success return 0 */
 }
@@ -972,13 +1796,19 @@ uint8_t bme680_set_idac_heater(bme680_handle_t *handle, uint8_t index, uint8_t r
         return 4;                                                                             /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                                       /* lock the bus */
+    {
+        return 1;                                                                             /* return error */
+    }
     prev = reg;
     if (a_bme680_iic_spi_write(handle, BME680_REG_IDAC_HEAT_X + index, &prev, 1) != 0)        /* write idac heater */
     {
         handle->debug_print("bme680: write idac heater failed.\n");                           /* write idac heater failed */
+        (void)a_bme680_bus_unlock(handle);                                                    /* unlock the bus */
 
         return 1;                                                                             /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                                        /* unlock the bus */
 
     return 0;                                                                                 /* success return 0 */
 }
@@ -1013,12 +1843,18 @@ uint8_t bme680_get_idac_heater(bme680_handle_t *handle, uint8_t index, uint8_t *
         return 4;                                                                          /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
+        return 1;                                                                          /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_IDAC_HEAT_X + index, reg, 1) != 0)        /* read idac heater */
     {
         handle->debug_print("bme680: read idac heater failed.\n");                         /* read idac heater failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
 
     return 0;                                                                              /* success return 0 */
 }
@@ -1034,7 +1870,7 @@ uint8_t bme680_get_idac_heater(bme680_handle_t *handle, uint8_t index, uint8_t *
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 index > 9
- * @note      none
+ * @note      the register is kept as written, so the ambient temperature feedback no longer updates this index
  */
 uint8_t bme680_set_resistance_heater(bme680_handle_t *handle, uint8_t index, uint8_t reg)
 {
@@ -1055,13 +1891,20 @@ uint8_t bme680_set_resistance_heater(bme680_handle_t *handle, uint8_t index, uin
         return 4;                                                                            /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                                      /* lock the bus */
+    {
+        return 1;                                                                            /* return error */
+    }
     prev = reg;
     if (a_bme680_iic_spi_write(handle, BME680_REG_RES_HEAT_X + index, &prev, 1) != 0)        /* write resistance heater */
     {
         handle->debug_print("bme680: write resistance heater failed.\n");                    /* write resistance heater failed */
+        (void)a_bme680_bus_unlock(handle);                                                   /* unlock the bus */
 
         return 1;                                                                            /* return error */
     }
+    handle->heat_target_mask &= (uint16_t)~(1 << index);                                     /* drop the heater target */
+    (void)a_bme680_bus_unlock(handle);                                                       /* unlock the bus */
 
     return 0;                                                                                /* success return 0 */
 }
@@ -1096,12 +1939,18 @@ uint8_t bme680_get_resistance_heater(bme680_handle_t *handle, uint8_t index, uin
         return 4;                                                                         /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                                   /* lock the bus */
+    {
+        return 1;                                                                         /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_RES_HEAT_X + index, reg, 1) != 0)        /* read resistance heater */
     {
         handle->debug_print("bme680: read resistance heater failed.\n");                  /* read resistance heater failed */
+        (void)a_bme680_bus_unlock(handle);                                                /* unlock the bus */
 
         return 1;                                                                         /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                                    /* unlock the bus */
 
     return 0;                                                                             /* success return 0 */
 }
@@ -1138,13 +1987,19 @@ uint8_t bme680_set_gas_wait(bme680_handle_t *handle, uint8_t index, uint8_t reg)
         return 4;                                                                            /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                                      /* lock the bus */
+    {
+        return 1;                                                                            /* return error */
+    }
     prev = reg;
     if (a_bme680_iic_spi_write(handle, BME680_REG_GAS_WAIT_X + index, &prev, 1) != 0)        /* write gas wait */
     {
         handle->debug_print("bme680: write gas wait failed.\n");                             /* write gas wait failed */
+        (void)a_bme680_bus_unlock(handle);                                                   /* unlock the bus */
 
         return 1;                                                                            /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                                       /* unlock the bus */
 
     return 0;                                                                                /* success return 0 */
 }
@@ -1179,12 +2034,18 @@ uint8_t bme680_get_gas_wait(bme680_handle_t *handle, uint8_t index, uint8_t *reg
         return 4;                                                                         /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                                   /* lock the bus */
+    {
+        return 1;                                                                         /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_GAS_WAIT_X + index, reg, 1) != 0)        /* read gas wait */
     {
         handle->debug_print("bme680: read gas wait failed.\n");                           /* read gas wait failed */
+        (void)a_bme680_bus_unlock(handle);                                                /* unlock the bus */
 
         return 1;                                                                         /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                                    /* unlock the bus */
 
     return 0;                                                                             /* success return 0 */
 }
@@ -1197,7 +2058,7 @@ uint8_t bme680_get_gas_wait(bme680_handle_t *handle, uint8_t index, uint8_t *reg
  *            - 1 soft reset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the chip is left in the sleep mode so a running free running mode is stopped
  */
 uint8_t bme680_soft_reset(bme680_handle_t *handle)
 {
@@ -1212,18 +2073,138 @@ uint8_t bme680_soft_reset(bme680_handle_t *handle)
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     reg = 0xB6;                                                                /* set the reset value */
     if (a_bme680_iic_spi_write(handle, BME680_REG_RESET, &reg, 1) != 0)        /* reset the chip */
     {
         handle->debug_print("bme680: reset failed.\n");                        /* reset failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
+    handle->page = 0;                                                          /* reset selects spi page 0 */
+    handle->continuous = 0;                                                    /* clear free running flag */
+    handle->cache_valid = 0;                                                   /* clear the cache */
     handle->delay_ms(5);                                                       /* delay 5ms */
+    (void)a_bme680_config_cache_load(handle);                                  /* reload configuration */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
 
+/**
+ * @brief     reset the chip and restore its configuration
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 recover failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 configuration cache is invalid
+ * @note      the cached ctrl, config and heater registers are written back in one burst with ctrl_meas last,
+ *            the calibration is checked against its checksum and only read from the nvm again on a mismatch,
+ *            the chip is left in the sleep mode so a running free running mode is stopped,
+ *            and the sample cache is dropped
+ */
+uint8_t bme680_recover(bme680_handle_t *handle)
+{
+    uint8_t i;
+    uint8_t id;
+    uint8_t reg;
+    uint16_t len;
+    uint8_t buf[70];
+
+    if (handle == NULL)                                                               /* check handle */
+    {
+        return 2;                                                                     /* return error */
+    }
+    if (handle->inited != 1)                                                          /* check handle initialization */
+    {
+        return 3;                                                                     /* return error */
+    }
+    if (handle->config_valid != 1)                                                    /* check configuration cache */
+    {
+        handle->debug_print("bme680: configuration cache is invalid.\n");             /* configuration cache is invalid */
+
+        return 4;                                                                     /* return error */
+    }
+
+    if (a_bme680_bus_lock(handle) != 0)                                               /* lock the bus */
+    {
+        return 1;                                                                     /* return error */
+    }
+    reg = 0xB6;                                                                       /* set the reset value */
+    if (a_bme680_iic_spi_write(handle, BME680_REG_RESET, &reg, 1) != 0)               /* reset the chip */
+    {
+        handle->debug_print("bme680: reset failed.\n");                               /* reset failed */
+        (void)a_bme680_bus_unlock(handle);                                            /* unlock the bus */
+
+        return 1;                                                                     /* return error */
+    }
+    handle->page = 0;                                                                 /* reset selects spi page 0 */
+    handle->continuous = 0;                                                           /* clear free running flag */
+    handle->delay_ms(5);                                                              /* delay 5ms */
+    len = 0;                                                                          /* init length */
+    for (i = 0; i < BME680_CONFIG_LEN; i++)                                           /* run all cached registers */
+    {
+        reg = (uint8_t)(BME680_CONFIG_START + i);                                     /* get the register */
+        if ((reg == 0x6E) || (reg == 0x6F))                                           /* skip reserved */
+        {
+            continue;                                                                 /* next */
+        }
+        if ((reg == BME680_REG_STATUS) || (reg == BME680_REG_CTRL_MEAS))              /* skip spi page and ctrl meas */
+        {
+            continue;                                                                 /* next */
+        }
+        buf[len] = reg;                                                               /* set the register */
+        buf[len + 1] = handle->config_cache[i];                                       /* set the value */
+        len += 2;                                                                     /* next pair */
+    }
+    reg = handle->config_cache[BME680_REG_CTRL_MEAS - BME680_CONFIG_START];           /* get ctrl meas */
+    reg &= ~(3 << 0);                                                                 /* set sleep mode */
+    buf[len] = BME680_REG_CTRL_MEAS;                                                  /* ctrl meas goes last */
+    buf[len + 1] = reg;                                                               /* set the value */
+    len += 2;                                                                         /* next pair */
+    if (a_bme680_write_pairs(handle, buf, len) != 0)                                  /* write all pairs */
+    {
+        handle->debug_print("bme680: restore configuration failed.\n");               /* restore configuration failed */
+        (void)a_bme680_bus_unlock(handle);                                            /* unlock the bus */
+
+        return 1;                                                                     /* return error */
+    }
+    if (a_bme680_iic_spi_read(handle, BME680_REG_ID, &id, 1) != 0)                    /* read chip id */
+    {
+        handle->debug_print("bme680: read id failed.\n");                             /* read id failed */
+        (void)a_bme680_bus_unlock(handle);                                            /* unlock the bus */
+
+        return 1;                                                                     /* return error */
+    }
+    if (id != 0x61)                                                                   /* check id */
+    {
+        handle->debug_print("bme680: id is error.\n");                                /* id is error */
+        (void)a_bme680_bus_unlock(handle);                                            /* unlock the bus */
+
+        return 1;                                                                     /* return error */
+    }
+    if (a_bme680_calibration_checksum(handle) != handle->calibration_checksum)        /* check calibration */
+    {
+        handle->debug_print("bme680: calibration checksum is error.\n");              /* calibration checksum is error */
+        if (a_bme680_get_nvm_calibration(handle) != 0)                                /* get nvm calibration */
+        {
+            (void)a_bme680_bus_unlock(handle);                                        /* unlock the bus */
+
+            return 1;                                                                 /* return error */
+        }
+    }
+    handle->cache_valid = 0;                                                          /* clear the cache */
+    (void)a_bme680_bus_unlock(handle);                                                /* unlock the bus */
+
+    return 0;                                                                         /* success return 0 */
+}
+
 /**
  * @brief      get new data status
  * @param[in]  *handle pointer to a bme680 handle structure
@@ -1248,13 +2229,19 @@ uint8_t bme680_get_new_data_status(bme680_handle_t *handle, bme680_bool_t *enabl
         return 3;                                                                   /* return error */
     }
 
-    if (a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, &prev, 1) != 0)       /* read status */
+    if (a_bme680_bus_lock(handle) != 0)                                             /* lock the bus */
+    {
+        return 1;                                                                   /* return error */
+    }
+    if (a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, &prev, 1) != 0)       /* read status */
     {
         handle->debug_print("bme680: read status failed.\n");                       /* read status failed */
+        (void)a_bme680_bus_unlock(handle);                                          /* unlock the bus */
 
         return 1;                                                                   /* return error */
     }
     *enable = (bme680_bool_t)((prev >> 7) & 0x01);                                  /* set bool */
+    (void)a_bme680_bus_unlock(handle);                                              /* unlock the bus */
 
     return 0;                                                                       /* success return 0 */
 }
@@ -1283,13 +2270,19 @@ uint8_t bme680_get_gas_measuring_status(bme680_handle_t *handle, bme680_bool_t *
         return 3;                                                                   /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                             /* lock the bus */
+    {
+        return 1;                                                                   /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, &prev, 1) != 0)       /* read status */
     {
         handle->debug_print("bme680: read status failed.\n");                       /* read status failed */
+        (void)a_bme680_bus_unlock(handle);                                          /* unlock the bus */
 
         return 1;                                                                   /* return error */
     }
     *enable = (bme680_bool_t)((prev >> 6) & 0x01);                                  /* set bool */
+    (void)a_bme680_bus_unlock(handle);                                              /* unlock the bus */
 
     return 0;                                                                       /* success return 0 */
 }
@@ -1318,13 +2311,19 @@ uint8_t bme680_get_measuring_status(bme680_handle_t *handle, bme680_bool_t *enab
         return 3;                                                                   /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                             /* lock the bus */
+    {
+        return 1;                                                                   /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, &prev, 1) != 0)       /* read status */
     {
         handle->debug_print("bme680: read status failed.\n");                       /* read status failed */
+        (void)a_bme680_bus_unlock(handle);                                          /* unlock the bus */
 
         return 1;                                                                   /* return error */
     }
     *enable = (bme680_bool_t)((prev >> 5) & 0x01);                                  /* set bool */
+    (void)a_bme680_bus_unlock(handle);                                              /* unlock the bus */
 
     return 0;                                                                       /* success return 0 */
 }
@@ -1353,13 +2352,19 @@ uint8_t bme680_get_gas_measuring_index(bme680_handle_t *handle, uint8_t *index)
         return 3;                                                                   /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                             /* lock the bus */
+    {
+        return 1;                                                                   /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, &prev, 1) != 0)       /* read status */
     {
         handle->debug_print("bme680: read status failed.\n");                       /* read status failed */
+        (void)a_bme680_bus_unlock(handle);                                          /* unlock the bus */
 
         return 1;                                                                   /* return error */
     }
     *index = (prev & 0xF);                                                          /* set index */
+    (void)a_bme680_bus_unlock(handle);                                              /* unlock the bus */
 
     return 0;                                                                       /* success return 0 */
 }
@@ -1388,13 +2393,19 @@ uint8_t bme680_get_gas_valid_status(bme680_handle_t *handle, bme680_bool_t *enab
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_GAS_R_LSB, &prev, 1) != 0)      /* read gas lsb */
     {
         handle->debug_print("bme680: read gas lsb failed.\n");                   /* read gas lsb failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
     *enable = (bme680_bool_t)((prev >> 5) & 0x01);                               /* set bool */
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -1423,13 +2434,19 @@ uint8_t bme680_get_heater_stability_status(bme680_handle_t *handle, bme680_bool_
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_GAS_R_LSB, &prev, 1) != 0)      /* read gas lsb */
     {
         handle->debug_print("bme680: read gas lsb failed.\n");                   /* read gas lsb failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
     *enable = (bme680_bool_t)((prev >> 4) & 0x01);                               /* set bool */
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -1458,9 +2475,14 @@ uint8_t bme680_set_spi_wire_3_data_interrupt(bme680_handle_t *handle, bme680_boo
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_HUM, &prev, 1) != 0)     /* read ctrl hum */
     {
         handle->debug_print("bme680: read ctrl hum failed.\n");                /* read ctrl hum failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
@@ -1469,9 +2491,11 @@ uint8_t bme680_set_spi_wire_3_data_interrupt(bme680_handle_t *handle, bme680_boo
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_HUM, &prev, 1) != 0)    /* write ctrl hum */
     {
         handle->debug_print("bme680: write ctrl hum failed.\n");               /* write ctrl hum failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1500,13 +2524,19 @@ uint8_t bme680_get_spi_wire_3_data_interrupt(bme680_handle_t *handle, bme680_boo
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_HUM, &prev, 1) != 0)     /* read ctrl hum */
     {
         handle->debug_print("bme680: read ctrl hum failed.\n");                /* read ctrl hum failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
     *enable = (bme680_bool_t)((prev >> 6) & 0x01);                             /* get bool */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1535,9 +2565,14 @@ uint8_t bme680_set_humidity_oversampling(bme680_handle_t *handle, bme680_oversam
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_HUM, &prev, 1) != 0)     /* read ctrl hum */
     {
         handle->debug_print("bme680: read ctrl hum failed.\n");                /* read ctrl hum failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
@@ -1546,9 +2581,12 @@ uint8_t bme680_set_humidity_oversampling(bme680_handle_t *handle, bme680_oversam
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_HUM, &prev, 1) != 0)    /* write ctrl hum */
     {
         handle->debug_print("bme680: write ctrl hum failed.\n");               /* write ctrl hum failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
+    handle->cache_valid = 0;                                                   /* drop the cached sample */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1577,13 +2615,19 @@ uint8_t bme680_get_humidity_oversampling(bme680_handle_t *handle, bme680_oversam
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_HUM, &prev, 1) != 0)     /* read ctrl hum */
     {
         handle->debug_print("bme680: read ctrl hum failed.\n");                /* read ctrl hum failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
     *oversampling = (bme680_oversampling_t)(prev & 0x07);                      /* get oversampling */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1597,7 +2641,7 @@ uint8_t bme680_get_humidity_oversampling(bme680_handle_t *handle, bme680_oversam
  *            - 1 set temperature oversampling failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      it also updates the next trigger of a running free running mode
  */
 uint8_t bme680_set_temperature_oversampling(bme680_handle_t *handle, bme680_oversampling_t oversampling)
 {
@@ -1612,9 +2656,14 @@ uint8_t bme680_set_temperature_oversampling(bme680_handle_t *handle, bme680_over
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)    /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");               /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
@@ -1623,9 +2672,18 @@ uint8_t bme680_set_temperature_oversampling(bme680_handle_t *handle, bme680_over
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)   /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");              /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
+    if (handle->continuous == 1)                                               /* check free running */
+    {
+        handle->continuous_ctrl_meas = prev;                                   /* next trigger uses it */
+        handle->continuous_ctrl_meas &= ~(3 << 0);                             /* clear the mode */
+        handle->continuous_ctrl_meas |= 0x01 << 0;                             /* set forced mode */
+    }
+    handle->cache_valid = 0;                                                   /* drop the cached sample */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1654,13 +2712,19 @@ uint8_t bme680_get_temperature_oversampling(bme680_handle_t *handle, bme680_over
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)    /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");               /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
     *oversampling = (bme680_oversampling_t)((prev >> 5) & 0x7);                /* set oversampling */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1674,7 +2738,7 @@ uint8_t bme680_get_temperature_oversampling(bme680_handle_t *handle, bme680_over
  *            - 1 set pressure oversampling failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      it also updates the next trigger of a running free running mode
  */
 uint8_t bme680_set_pressure_oversampling(bme680_handle_t *handle, bme680_oversampling_t oversampling)
 {
@@ -1689,9 +2753,14 @@ uint8_t bme680_set_pressure_oversampling(bme680_handle_t *handle, bme680_oversam
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)    /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");               /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
@@ -1700,9 +2769,18 @@ uint8_t bme680_set_pressure_oversampling(bme680_handle_t *handle, bme680_oversam
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)   /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");              /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
+    if (handle->continuous == 1)                                               /* check free running */
+    {
+        handle->continuous_ctrl_meas = prev;                                   /* next trigger uses it */
+        handle->continuous_ctrl_meas &= ~(3 << 0);                             /* clear the mode */
+        handle->continuous_ctrl_meas |= 0x01 << 0;                             /* set forced mode */
+    }
+    handle->cache_valid = 0;                                                   /* drop the cached sample */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1731,13 +2809,19 @@ uint8_t bme680_get_pressure_oversampling(bme680_handle_t *handle, bme680_oversam
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)    /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");               /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
     *oversampling = (bme680_oversampling_t)((prev >> 2) & 0x7);                /* set oversampling */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1751,7 +2835,7 @@ uint8_t bme680_get_pressure_oversampling(bme680_handle_t *handle, bme680_oversam
  *            - 1 set mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the sleep mode stops a running free running mode
  */
 uint8_t bme680_set_mode(bme680_handle_t *handle, bme680_mode_t mode)
 {
@@ -1766,9 +2850,14 @@ uint8_t bme680_set_mode(bme680_handle_t *handle, bme680_mode_t mode)
         return 3;                                                                   /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                             /* lock the bus */
+    {
+        return 1;                                                                   /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)         /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");                    /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                          /* unlock the bus */
 
         return 1;                                                                   /* return error */
     }
@@ -1777,9 +2866,16 @@ uint8_t bme680_set_mode(bme680_handle_t *handle, bme680_mode_t mode)
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)        /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");                   /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                          /* unlock the bus */
 
         return 1;                                                                   /* return error */
     }
+    if ((handle->continuous == 1) && (mode == BME680_MODE_SLEEP))                   /* check free running */
+    {
+        handle->continuous = 0;                                                     /* sleep ends the free running */
+    }
+    handle->cache_valid = 0;                                                        /* drop the cached sample */
+    (void)a_bme680_bus_unlock(handle);                                              /* unlock the bus */
 
     return 0;                                                                       /* success return 0 */
 }
@@ -1808,13 +2904,19 @@ uint8_t bme680_get_mode(bme680_handle_t *handle, bme680_mode_t *mode)
         return 3;                                                              /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                        /* lock the bus */
+    {
+        return 1;                                                              /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)    /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");               /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                     /* unlock the bus */
 
         return 1;                                                              /* return error */
     }
     *mode = (bme680_mode_t)((prev >> 0) & 0x3);                                /* set mode */
+    (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
 
     return 0;                                                                  /* success return 0 */
 }
@@ -1843,9 +2945,14 @@ uint8_t bme680_set_filter(bme680_handle_t *handle, bme680_filter_t filter)
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CONFIG, &prev, 1) != 0)         /* read config */
     {
         handle->debug_print("bme680: read config failed.\n");                    /* read config failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
@@ -1854,9 +2961,12 @@ uint8_t bme680_set_filter(bme680_handle_t *handle, bme680_filter_t filter)
     if (a_bme680_iic_spi_write(handle, BME680_REG_CONFIG, &prev, 1) != 0)        /* write config */
     {
         handle->debug_print("bme680: write config failed.\n");                   /* write config failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
+    handle->cache_valid = 0;                                                     /* drop the cached sample */
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -1885,13 +2995,19 @@ uint8_t bme680_get_filter(bme680_handle_t *handle, bme680_filter_t *filter)
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CONFIG, &prev, 1) != 0)         /* read config */
     {
         handle->debug_print("bme680: read config failed.\n");                    /* read config failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
     *filter = (bme680_filter_t)((prev >> 2) & 0x07);                             /* set filter */
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -1920,9 +3036,14 @@ uint8_t bme680_set_spi_wire(bme680_handle_t *handle, bme680_spi_wire_t spi)
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CONFIG, &prev, 1) != 0)         /* read config */
     {
         handle->debug_print("bme680: read config failed.\n");                    /* read config failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
@@ -1931,9 +3052,11 @@ uint8_t bme680_set_spi_wire(bme680_handle_t *handle, bme680_spi_wire_t spi)
     if (a_bme680_iic_spi_write(handle, BME680_REG_CONFIG, &prev, 1) != 0)        /* write config */
     {
         handle->debug_print("bme680: write config failed.\n");                   /* write config failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -1962,13 +3085,19 @@ uint8_t bme680_get_spi_wire(bme680_handle_t *handle, bme680_spi_wire_t *spi)
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CONFIG, &prev, 1) != 0)         /* read config */
     {
         handle->debug_print("bme680: read config failed.\n");                    /* read config failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
     *spi = (bme680_spi_wire_t)((prev >> 0) & 0x01);                              /* get spi */
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -1997,9 +3126,14 @@ uint8_t bme680_set_heater_off(bme680_handle_t *handle, bme680_bool_t enable)
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_GAS_0, &prev, 1) != 0)     /* read ctrl gas0 */
     {
         handle->debug_print("bme680: read ctrl gas0 failed.\n");                 /* read ctrl gas0 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
@@ -2008,9 +3142,11 @@ uint8_t bme680_set_heater_off(bme680_handle_t *handle, bme680_bool_t enable)
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_GAS_0, &prev, 1) != 0)    /* write ctrl gas0 */
     {
         handle->debug_print("bme680: write ctrl gas0 failed.\n");                /* write ctrl gas0 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -2039,13 +3175,19 @@ uint8_t bme680_get_heater_off(bme680_handle_t *handle, bme680_bool_t *enable)
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_GAS_0, &prev, 1) != 0)     /* read ctrl gas0 */
     {
         handle->debug_print("bme680: read ctrl gas0 failed.\n");                 /* read ctrl gas0 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
     *enable = (bme680_bool_t)((prev >> 3) & 0x01);                               /* get bool */
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -2074,9 +3216,14 @@ uint8_t bme680_set_run_gas(bme680_handle_t *handle, bme680_bool_t enable)
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_GAS_1, &prev, 1) != 0)     /* read ctrl gas1 */
     {
         handle->debug_print("bme680: read ctrl gas1 failed.\n");                 /* read ctrl gas1 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
@@ -2085,9 +3232,11 @@ uint8_t bme680_set_run_gas(bme680_handle_t *handle, bme680_bool_t enable)
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_GAS_1, &prev, 1) != 0)    /* write ctrl gas1 */
     {
         handle->debug_print("bme680: write ctrl gas1 failed.\n");                /* write ctrl gas1 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -2116,13 +3265,19 @@ uint8_t bme680_get_run_gas(bme680_handle_t *handle, bme680_bool_t *enable)
         return 3;                                                                /* return error */
     }
 
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_GAS_1, &prev, 1) != 0)     /* read ctrl gas1 */
     {
         handle->debug_print("bme680: read ctrl gas1 failed.\n");                 /* read ctrl gas1 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
     *enable = (bme680_bool_t)((prev >> 4) & 0x01);                               /* get bool */
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
     
     return 0;                                                                    /* success return 0 */
 }
@@ -2158,9 +3313,14 @@ uint8_t bme680_set_convert_index(bme680_handle_t *handle, uint8_t index)
         return 4;                                                                /* return error */
     }
     
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_GAS_1, &prev, 1) != 0)     /* read ctrl gas1 */
     {
         handle->debug_print("bme680: read ctrl gas1 failed.\n");                 /* read ctrl gas1 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
@@ -2169,9 +3329,11 @@ uint8_t bme680_set_convert_index(bme680_handle_t *handle, uint8_t index)
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_GAS_1, &prev, 1) != 0)    /* write ctrl gas1 */
     {
         handle->debug_print("bme680: write ctrl gas1 failed.\n");                /* write ctrl gas1 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -2200,13 +3362,19 @@ uint8_t bme680_get_convert_index(bme680_handle_t *handle, uint8_t *index)
         return 3;                                                                /* return error */
     }
     
+    if (a_bme680_bus_lock(handle) != 0)                                          /* lock the bus */
+    {
+        return 1;                                                                /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_GAS_1, &prev, 1) != 0)     /* read ctrl gas1 */
     {
         handle->debug_print("bme680: read ctrl gas1 failed.\n");                 /* read ctrl gas1 failed */
+        (void)a_bme680_bus_unlock(handle);                                       /* unlock the bus */
 
         return 1;                                                                /* return error */
     }
     *index = prev & 0x0F;                                                        /* set index */
+    (void)a_bme680_bus_unlock(handle);                                           /* unlock the bus */
 
     return 0;                                                                    /* success return 0 */
 }
@@ -2371,9 +3539,14 @@ uint8_t bme680_read_gas_resistance(bme680_handle_t *handle, uint16_t *adc_raw, u
         return 3;                                                                          /* return error */
     }
     
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
+        return 1;                                                                          /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");                           /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2382,15 +3555,17 @@ uint8_t bme680_read_gas_resistance(bme680_handle_t *handle, uint16_t *adc_raw, u
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)               /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");                          /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
-    timeout = 10 * 1000;                                                                   /* set timeout */
+    timeout = a_bme680_conversion_timeout(handle);                                         /* set timeout */
     while (timeout != 0)                                                                   /* check timeout */
     {
         if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)            /* read ctrl meas */
         {
             handle->debug_print("bme680: read ctrl meas failed.\n");                       /* read ctrl meas failed */
+            (void)a_bme680_bus_unlock(handle);                                             /* unlock the bus */
 
             return 1;                                                                      /* return error */
         }
@@ -2404,6 +3579,7 @@ uint8_t bme680_read_gas_resistance(bme680_handle_t *handle, uint16_t *adc_raw, u
     if (timeout == 0)                                                                      /* check timeout */
     {
         handle->debug_print("bme680: read timeout.\n");                                    /* read timeout */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 5;                                                                          /* return error */
     }
@@ -2411,18 +3587,21 @@ uint8_t bme680_read_gas_resistance(bme680_handle_t *handle, uint16_t *adc_raw, u
     if (res != 0)
     {
         handle->debug_print("bme680: read failed.\n");                                     /* read failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
     if ((buf[1] & (1 << 5)) == 0)                                                          /* check gas valid */
     {
         handle->debug_print("bme680: gas is invalid.\n");                                  /* gas is invalid */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 6;                                                                          /* return error */
     }
     if ((buf[1] & (1 << 4)) == 0)                                                          /* check heat */
     {
         handle->debug_print("bme680: heater is not stable.\n");                            /* heater is not stable */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 7;                                                                          /* return error */
     }
@@ -2432,16 +3611,19 @@ uint8_t bme680_read_gas_resistance(bme680_handle_t *handle, uint16_t *adc_raw, u
     if (res != 0)                                                                          /* check result */
     {
         handle->debug_print("bme680: compensate gas resistance failed.\n");                /* compensate gas resistance failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
     if (a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, &prev, 1) != 0)              /* read status */
     {
         handle->debug_print("bme680: read status failed.\n");                              /* read status failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
     *index = (prev & 0xF);                                                                 /* set index */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
     
     return 0;                                                                              /* success return 0 */
 }
@@ -2478,9 +3660,22 @@ uint8_t bme680_read_pressure(bme680_handle_t *handle, uint32_t *pressure_raw, fl
         return 3;                                                                          /* return error */
     }
     
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
+        return 1;                                                                          /* return error */
+    }
+    if (a_bme680_cache_check(handle, BME680_CACHE_PRESSURE) != 0)                          /* check the cache */
+    {
+        *pressure_raw = handle->cache_pressure_raw;                                        /* get cached pressure raw */
+        *pressure_pa = handle->cache_pressure_pa;                                          /* get cached pressure */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 0;                                                                          /* success return 0 */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");                           /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2489,15 +3684,17 @@ uint8_t bme680_read_pressure(bme680_handle_t *handle, uint32_t *pressure_raw, fl
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)               /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");                          /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
-    timeout = 10 * 1000;                                                                   /* set timeout */
+    timeout = a_bme680_conversion_timeout(handle);                                         /* set timeout */
     while (timeout != 0)                                                                   /* check timeout */
     {
         if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)            /* read ctrl meas */
         {
             handle->debug_print("bme680: read ctrl meas failed.\n");                       /* read ctrl meas failed */
+            (void)a_bme680_bus_unlock(handle);                                             /* unlock the bus */
 
             return 1;                                                                      /* return error */
         }
@@ -2511,6 +3708,7 @@ uint8_t bme680_read_pressure(bme680_handle_t *handle, uint32_t *pressure_raw, fl
     if (timeout == 0)                                                                      /* check timeout */
     {
         handle->debug_print("bme680: read timeout.\n");                                    /* read timeout */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 5;                                                                          /* return error */
     }
@@ -2518,6 +3716,7 @@ uint8_t bme680_read_pressure(bme680_handle_t *handle, uint32_t *pressure_raw, fl
     if (res != 0)
     {
         handle->debug_print("bme680: read failed.\n");                                     /* read failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2528,9 +3727,16 @@ uint8_t bme680_read_pressure(bme680_handle_t *handle, uint32_t *pressure_raw, fl
     if (res != 0)
     {
         handle->debug_print("bme680: compensate temperature failed.\n");                   /* compensate temperature failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
+    if (a_bme680_ambient_feedback(handle, temperature_c) != 0)                             /* ambient feedback */
+    {
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 1;                                                                          /* return error */
+    }
     *pressure_raw = ((((uint32_t)(buf[0])) << 12) |
                     (((uint32_t)(buf[1])) << 4) |
                     (((uint32_t)(buf[2])) >> 4));                                          /* set pressure raw */
@@ -2538,9 +3744,16 @@ uint8_t bme680_read_pressure(bme680_handle_t *handle, uint32_t *pressure_raw, fl
     if (res != 0)
     {
         handle->debug_print("bme680: compensate pressure failed.\n");                      /* compensate pressure failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
+    handle->cache_temperature_raw = temperature_raw;                                       /* save temperature raw */
+    handle->cache_temperature_c = temperature_c;                                           /* save temperature */
+    handle->cache_pressure_raw = *pressure_raw;                                            /* save pressure raw */
+    handle->cache_pressure_pa = *pressure_pa;                                              /* save pressure */
+    a_bme680_cache_save(handle, BME680_CACHE_TEMPERATURE | BME680_CACHE_PRESSURE);         /* save the cache */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
 
     return 0;                                                                              /* success return 0 */
 }
@@ -2575,9 +3788,22 @@ uint8_t bme680_read_temperature(bme680_handle_t *handle, uint32_t *temperature_r
         return 3;                                                                          /* return error */
     }
     
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
+        return 1;                                                                          /* return error */
+    }
+    if (a_bme680_cache_check(handle, BME680_CACHE_TEMPERATURE) != 0)                       /* check the cache */
+    {
+        *temperature_raw = handle->cache_temperature_raw;                                  /* get cached temperature raw */
+        *temperature_c = handle->cache_temperature_c;                                      /* get cached temperature */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 0;                                                                          /* success return 0 */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");                           /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2586,15 +3812,17 @@ uint8_t bme680_read_temperature(bme680_handle_t *handle, uint32_t *temperature_r
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)               /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");                          /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
-    timeout = 10 * 1000;                                                                   /* set timeout */
+    timeout = a_bme680_conversion_timeout(handle);                                         /* set timeout */
     while (timeout != 0)                                                                   /* check timeout */
     {
         if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)            /* read ctrl meas */
         {
             handle->debug_print("bme680: read ctrl meas failed.\n");                       /* read ctrl meas failed */
+            (void)a_bme680_bus_unlock(handle);                                             /* unlock the bus */
 
             return 1;                                                                      /* return error */
         }
@@ -2608,6 +3836,7 @@ uint8_t bme680_read_temperature(bme680_handle_t *handle, uint32_t *temperature_r
     if (timeout == 0)                                                                      /* check timeout */
     {
         handle->debug_print("bme680: read timeout.\n");                                    /* read timeout */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 5;                                                                          /* return error */
     }
@@ -2615,6 +3844,7 @@ uint8_t bme680_read_temperature(bme680_handle_t *handle, uint32_t *temperature_r
     if (res != 0)
     {
         handle->debug_print("bme680: read failed.\n");                                     /* read failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2625,9 +3855,20 @@ uint8_t bme680_read_temperature(bme680_handle_t *handle, uint32_t *temperature_r
     if (res != 0)
     {
         handle->debug_print("bme680: compensate temperature failed.\n");                   /* compensate temperature failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
+    if (a_bme680_ambient_feedback(handle, *temperature_c) != 0)                            /* ambient feedback */
+    {
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 1;                                                                          /* return error */
+    }
+    handle->cache_temperature_raw = *temperature_raw;                                      /* save temperature raw */
+    handle->cache_temperature_c = *temperature_c;                                          /* save temperature */
+    a_bme680_cache_save(handle, BME680_CACHE_TEMPERATURE);                                 /* save the cache */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
 
     return 0;                                                                              /* success return 0 */
 }
@@ -2664,9 +3905,22 @@ uint8_t bme680_read_humidity(bme680_handle_t *handle, uint32_t *humidity_raw, fl
         return 3;                                                                          /* return error */
     }
     
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
+        return 1;                                                                          /* return error */
+    }
+    if (a_bme680_cache_check(handle, BME680_CACHE_HUMIDITY) != 0)                          /* check the cache */
+    {
+        *humidity_raw = handle->cache_humidity_raw;                                        /* get cached humidity raw */
+        *humidity_percentage = handle->cache_humidity_percentage;                          /* get cached humidity */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 0;                                                                          /* success return 0 */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");                           /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2675,15 +3929,17 @@ uint8_t bme680_read_humidity(bme680_handle_t *handle, uint32_t *humidity_raw, fl
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)               /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");                          /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
-    timeout = 10 * 1000;                                                                   /* set timeout */
+    timeout = a_bme680_conversion_timeout(handle);                                         /* set timeout */
     while (timeout != 0)                                                                   /* check timeout */
     {
         if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)            /* read ctrl meas */
         {
             handle->debug_print("bme680: read ctrl meas failed.\n");                       /* read ctrl meas failed */
+            (void)a_bme680_bus_unlock(handle);                                             /* unlock the bus */
 
             return 1;                                                                      /* return error */
         }
@@ -2697,6 +3953,7 @@ uint8_t bme680_read_humidity(bme680_handle_t *handle, uint32_t *humidity_raw, fl
     if (timeout == 0)                                                                      /* check timeout */
     {
         handle->debug_print("bme680: read timeout.\n");                                    /* read timeout */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 5;                                                                          /* return error */
     }
@@ -2704,6 +3961,7 @@ uint8_t bme680_read_humidity(bme680_handle_t *handle, uint32_t *humidity_raw, fl
     if (res != 0)
     {
         handle->debug_print("bme680: read failed.\n");                                     /* read failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2714,17 +3972,31 @@ uint8_t bme680_read_humidity(bme680_handle_t *handle, uint32_t *humidity_raw, fl
     if (res != 0)
     {
         handle->debug_print("bme680: compensate temperature failed.\n");                   /* compensate temperature failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
+    if (a_bme680_ambient_feedback(handle, temperature_c) != 0)                             /* ambient feedback */
+    {
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 1;                                                                          /* return error */
+    }
     *humidity_raw = (uint32_t)buf[6] << 8 | buf[7];                                        /* set humidity raw */
     res = a_bme680_compensate_humidity(handle, *humidity_raw, humidity_percentage);        /* compensate humidity */
     if (res != 0)
     {
         handle->debug_print("bme680: compensate humidity failed.\n");                      /* compensate humidity failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
+    handle->cache_temperature_raw = temperature_raw;                                       /* save temperature raw */
+    handle->cache_temperature_c = temperature_c;                                           /* save temperature */
+    handle->cache_humidity_raw = *humidity_raw;                                            /* save humidity raw */
+    handle->cache_humidity_percentage = *humidity_percentage;                              /* save humidity */
+    a_bme680_cache_save(handle, BME680_CACHE_TEMPERATURE | BME680_CACHE_HUMIDITY);         /* save the cache */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
 
     return 0;                                                                              /* success return 0 */
 }
@@ -2765,9 +4037,14 @@ uint8_t bme680_read_temperature_pressure_humidity(bme680_handle_t *handle, uint3
         return 3;                                                                          /* return error */
     }
     
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
+        return 1;                                                                          /* return error */
+    }
     if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                /* read ctrl meas */
     {
         handle->debug_print("bme680: read ctrl meas failed.\n");                           /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2776,15 +4053,17 @@ uint8_t bme680_read_temperature_pressure_humidity(bme680_handle_t *handle, uint3
     if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)               /* write ctrl meas */
     {
         handle->debug_print("bme680: write ctrl meas failed.\n");                          /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
-    timeout = 10 * 1000;                                                                   /* set timeout */
+    timeout = a_bme680_conversion_timeout(handle);                                         /* set timeout */
     while (timeout != 0)                                                                   /* check timeout */
     {
         if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)            /* read ctrl meas */
         {
             handle->debug_print("bme680: read ctrl meas failed.\n");                       /* read ctrl meas failed */
+            (void)a_bme680_bus_unlock(handle);                                             /* unlock the bus */
 
             return 1;                                                                      /* return error */
         }
@@ -2798,6 +4077,7 @@ uint8_t bme680_read_temperature_pressure_humidity(bme680_handle_t *handle, uint3
     if (timeout == 0)                                                                      /* check timeout */
     {
         handle->debug_print("bme680: read timeout.\n");                                    /* read timeout */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 5;                                                                          /* return error */
     }
@@ -2805,6 +4085,7 @@ uint8_t bme680_read_temperature_pressure_humidity(bme680_handle_t *handle, uint3
     if (res != 0)
     {
         handle->debug_print("bme680: read failed.\n");                                     /* read failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 1;                                                                          /* return error */
     }
@@ -2815,9 +4096,16 @@ uint8_t bme680_read_temperature_pressure_humidity(bme680_handle_t *handle, uint3
     if (res != 0)
     {
         handle->debug_print("bme680: compensate temperature failed.\n");                   /* compensate temperature failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
+    if (a_bme680_ambient_feedback(handle, *temperature_c) != 0)                            /* ambient feedback */
+    {
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 1;                                                                          /* return error */
+    }
     *pressure_raw = ((((uint32_t)(buf[0])) << 12) |
                     (((uint32_t)(buf[1])) << 4) |
                     (((uint32_t)(buf[2])) >> 4));                                          /* set pressure raw */
@@ -2825,6 +4113,7 @@ uint8_t bme680_read_temperature_pressure_humidity(bme680_handle_t *handle, uint3
     if (res != 0)
     {
         handle->debug_print("bme680: compensate pressure failed.\n");                      /* compensate pressure failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
@@ -2833,9 +4122,18 @@ uint8_t bme680_read_temperature_pressure_humidity(bme680_handle_t *handle, uint3
     if (res != 0)
     {
         handle->debug_print("bme680: compensate humidity failed.\n");                      /* compensate humidity failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
 
         return 4;                                                                          /* return error */
     }
+    handle->cache_temperature_raw = *temperature_raw;                                      /* save temperature raw */
+    handle->cache_temperature_c = *temperature_c;                                          /* save temperature */
+    handle->cache_pressure_raw = *pressure_raw;                                            /* save pressure raw */
+    handle->cache_pressure_pa = *pressure_pa;                                              /* save pressure */
+    handle->cache_humidity_raw = *humidity_raw;                                            /* save humidity raw */
+    handle->cache_humidity_percentage = *humidity_percentage;                              /* save humidity */
+    a_bme680_cache_save(handle, BME680_CACHE_ALL);                                         /* save the cache */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
 
     return 0;                                                                              /* success return 0 */
 }
@@ -2862,7 +4160,8 @@ uint8_t bme680_read_temperature_pressure_humidity(bme680_handle_t *handle, uint3
  *             - 5 read timeout
  *             - 6 gas is invalid
  *             - 7 heater is not stable
- * @note       none
+ * @note       it is bme680_read_sample with all outputs,
+ *             the temperature pressure and humidity are still set when it fails with 6 or 7
  */
 uint8_t bme680_read(bme680_handle_t *handle, uint32_t *temperature_raw, float *temperature_c,
                     uint32_t *pressure_raw, float *pressure_pa,
@@ -2870,9 +4169,7 @@ uint8_t bme680_read(bme680_handle_t *handle, uint32_t *temperature_raw, float *t
                     uint16_t *adc_raw, uint8_t *adc_range, float *ohms, uint8_t *index)
 {
     uint8_t res;
-    uint8_t prev;
-    uint32_t timeout;
-    uint8_t buf[8];
+    bme680_sample_t sample;
 
     if (handle == NULL)                                                                    /* check handle */
     {
@@ -2883,132 +4180,1065 @@ uint8_t bme680_read(bme680_handle_t *handle, uint32_t *temperature_raw, float *t
         return 3;                                                                          /* return error */
     }
     
-    if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                /* read ctrl meas */
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
     {
-        handle->debug_print("bme680: read ctrl meas failed.\n");                           /* read ctrl meas failed */
-
         return 1;                                                                          /* return error */
     }
-    prev &= ~(3 << 0);                                                                     /* clear settings */
-    prev |= 0x01 << 0;                                                                     /* set forced mode */
-    if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)               /* write ctrl meas */
+    res = a_bme680_read_sample(handle, BME680_OUTPUT_ALL, &sample);                        /* read all outputs */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
+    if ((sample.mask & BME680_OUTPUT_TEMPERATURE) != 0)                                    /* check temperature */
     {
-        handle->debug_print("bme680: write ctrl meas failed.\n");                          /* write ctrl meas failed */
-
-        return 1;                                                                          /* return error */
+        *temperature_raw = sample.temperature_raw;                                         /* set temperature raw */
+        *temperature_c = sample.temperature_c;                                             /* set temperature */
     }
-    timeout = 10 * 1000;                                                                   /* set timeout */
-    while (timeout != 0)                                                                   /* check timeout */
+    if ((sample.mask & BME680_OUTPUT_PRESSURE) != 0)                                       /* check pressure */
     {
-        if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)            /* read ctrl meas */
-        {
-            handle->debug_print("bme680: read ctrl meas failed.\n");                       /* read ctrl meas failed */
-
-            return 1;                                                                      /* return error */
-        }
-        if ((prev & 0x03) == 0)                                                            /* if finished */
-        {
-            break;                                                                         /* break */
-        }
-        handle->delay_ms(1);                                                               /* delay 1ms */
-        timeout--;                                                                         /* timeout-- */
+        *pressure_raw = sample.pressure_raw;                                               /* set pressure raw */
+        *pressure_pa = sample.pressure_pa;                                                 /* set pressure */
     }
-    if (timeout == 0)                                                                      /* check timeout */
+    if ((sample.mask & BME680_OUTPUT_HUMIDITY) != 0)                                       /* check humidity */
     {
-        handle->debug_print("bme680: read timeout.\n");                                    /* read timeout */
-
-        return 5;                                                                          /* return error */
+        *humidity_raw = sample.humidity_raw;                                               /* set humidity raw */
+        *humidity_percentage = sample.humidity_percentage;                                 /* set humidity */
     }
-    res = a_bme680_iic_spi_read(handle, BME680_REG_PRESS_MSB, buf, 8);                     /* read temperature pressure and humidity */
-    if (res != 0)
+    if ((sample.mask & BME680_OUTPUT_GAS) != 0)                                            /* check gas */
     {
-        handle->debug_print("bme680: read failed.\n");                                     /* read failed */
-
-        return 1;                                                                          /* return error */
+        *adc_raw = sample.adc_raw;                                                         /* set adc raw */
+        *adc_range = sample.adc_range;                                                     /* set adc range */
+        *ohms = sample.ohms;                                                               /* set ohms */
+        *index = sample.index;                                                             /* set index */
     }
-    *temperature_raw = ((((uint32_t)(buf[3])) << 12) |
-                       (((uint32_t)(buf[4])) << 4) |
-                       ((uint32_t)buf[5] >> 4));                                           /* set temperature raw */
-    res = a_bme680_compensate_temperature(handle, *temperature_raw, temperature_c);        /* compensate temperature */
-    if (res != 0)
-    {
-        handle->debug_print("bme680: compensate temperature failed.\n");                   /* compensate temperature failed */
+    
+    return res;                                                                            /* return the result */
+}
 
-        return 4;                                                                          /* return error */
+/**
+ * @brief      read the selected outputs
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  mask output mask, the or of bme680_output_t
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a converted pressure buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_percentage pointer to a converted humidity percentage buffer
+ * @param[out] *adc_raw pointer to an adc raw buffer
+ * @param[out] *adc_range pointer to an adc range buffer
+ * @param[out] *ohms pointer to an ohms buffer
+ * @param[out] *index pointer to a heater index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 read timeout
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ *             - 8 mask is invalid
+ * @note       the buffers of the unselected outputs are not used and can be NULL,
+ *             the compensation of the unselected outputs and the gas registers read are skipped,
+ *             the temperature is still compensated internally when pressure or humidity is selected
+ */
+uint8_t bme680_read_selective(bme680_handle_t *handle, uint8_t mask,
+                              uint32_t *temperature_raw, float *temperature_c,
+                              uint32_t *pressure_raw, float *pressure_pa,
+                              uint32_t *humidity_raw, float *humidity_percentage,
+                              uint16_t *adc_raw, uint8_t *adc_range, float *ohms, uint8_t *index)
+{
+    uint8_t res;
+    bme680_sample_t sample;
+
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
     }
-    *pressure_raw = ((((uint32_t)(buf[0])) << 12) |
-                    (((uint32_t)(buf[1])) << 4) |
-                    (((uint32_t)(buf[2])) >> 4));                                          /* set pressure raw */
-    res = a_bme680_compensate_pressure(handle, *pressure_raw, pressure_pa);                /* compensate pressure */
-    if (res != 0)
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        handle->debug_print("bme680: compensate pressure failed.\n");                      /* compensate pressure failed */
-
-        return 4;                                                                          /* return error */
+        return 3;                                                                          /* return error */
     }
-    *humidity_raw = (uint32_t)buf[6] << 8 | buf[7];                                        /* set humidity raw */
-    res = a_bme680_compensate_humidity(handle, *humidity_raw, humidity_percentage);        /* compensate humidity */
-    if (res != 0)
+    if (((mask & BME680_OUTPUT_ALL) == 0) || ((mask & ~BME680_OUTPUT_ALL) != 0))           /* check mask */
     {
-        handle->debug_print("bme680: compensate humidity failed.\n");                      /* compensate humidity failed */
+        handle->debug_print("bme680: mask is invalid.\n");                                 /* mask is invalid */
 
-        return 4;                                                                          /* return error */
+        return 8;                                                                          /* return error */
     }
-    
-    res = a_bme680_iic_spi_read(handle, BME680_REG_GAS_R_MSB, buf, 2);                     /* read gas */
-    if (res != 0)
-    {
-        handle->debug_print("bme680: read failed.\n");                                     /* read failed */
 
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
         return 1;                                                                          /* return error */
     }
-    if ((buf[1] & (1 << 5)) == 0)                                                          /* check gas valid */
+    res = a_bme680_read_sample(handle, mask, &sample);                                     /* read the sample */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("bme680: gas is invalid.\n");                                  /* gas is invalid */
-
-        return 6;                                                                          /* return error */
+        return res;                                                                        /* return error */
     }
-    if ((buf[1] & (1 << 4)) == 0)                                                          /* check heat */
+    if ((mask & BME680_OUTPUT_TEMPERATURE) != 0)                                           /* check temperature */
     {
-        handle->debug_print("bme680: heater is not stable.\n");                            /* heater is not stable */
-
-        return 7;                                                                          /* return error */
+        *temperature_raw = sample.temperature_raw;                                         /* set temperature raw */
+        *temperature_c = sample.temperature_c;                                             /* set temperature */
     }
-    *adc_raw = (((uint16_t)buf[0]) << 2) | ((buf[1] >> 6) & 0x03);                         /* set adc raw */
-    *adc_range = buf[1] & 0x0F;                                                            /* set adc range */
-    res = a_bme680_compensate_gas_resistance(handle, *adc_raw , *adc_range, ohms);         /* compensate gas resistance */
-    if (res != 0)                                                                          /* check result */
+    if ((mask & BME680_OUTPUT_PRESSURE) != 0)                                              /* check pressure */
     {
-        handle->debug_print("bme680: compensate gas resistance failed.\n");                /* compensate gas resistance failed */
-
-        return 4;                                                                          /* return error */
+        *pressure_raw = sample.pressure_raw;                                               /* set pressure raw */
+        *pressure_pa = sample.pressure_pa;                                                 /* set pressure */
     }
-    if (a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, &prev, 1) != 0)              /* read status */
+    if ((mask & BME680_OUTPUT_HUMIDITY) != 0)                                              /* check humidity */
     {
-        handle->debug_print("bme680: read status failed.\n");                              /* read status failed */
-
-        return 1;                                                                          /* return error */
+        *humidity_raw = sample.humidity_raw;                                               /* set humidity raw */
+        *humidity_percentage = sample.humidity_percentage;                                 /* set humidity */
     }
-    *index = (prev & 0xF);                                                                 /* set index */
-    
+    if ((mask & BME680_OUTPUT_GAS) != 0)                                                   /* check gas */
+    {
+        *adc_raw = sample.adc_raw;                                                         /* set adc raw */
+        *adc_range = sample.adc_range;                                                     /* set adc range */
+        *ohms = sample.ohms;                                                               /* set ohms */
+        *index = sample.index;                                                             /* set index */
+    }
+
     return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     set the chip register
- * @param[in] *handle pointer to a bme680 handle structure
- * @param[in] reg register address
- * @param[in] *buf pointer to a data buffer
- * @param[in] len data length
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- *            - 2 handle is NULL
+ * @brief      read one sample
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  mask output mask, the or of bme680_output_t
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 read timeout
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ *             - 8 mask is invalid
+ * @note       sample->mask holds the outputs which are valid, it is also set when 6 or 7 is returned
+ */
+uint8_t bme680_read_sample(bme680_handle_t *handle, uint8_t mask, bme680_sample_t *sample)
+{
+    uint8_t res;
+
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (((mask & BME680_OUTPUT_ALL) == 0) || ((mask & ~BME680_OUTPUT_ALL) != 0))           /* check mask */
+    {
+        handle->debug_print("bme680: mask is invalid.\n");                                 /* mask is invalid */
+
+        return 8;                                                                          /* return error */
+    }
+
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
+        return 1;                                                                          /* return error */
+    }
+    res = a_bme680_read_sample(handle, mask, sample);                                      /* read the sample */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
+
+    return res;                                                                            /* return the result */
+}
+
+/**
+ * @brief      read a batch of samples
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  mask output mask, the or of bme680_output_t
+ * @param[out] *sample pointer to a sample array
+ * @param[in]  len sample array length
+ * @param[out] *count pointer to a filled sample count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 read timeout
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ *             - 8 mask is invalid
+ * @note       the forced conversions run back to back and the bus is locked for each one,
+ *             it stops at the first failed sample and count is the number of the valid samples before it
+ */
+uint8_t bme680_read_samples(bme680_handle_t *handle, uint8_t mask, bme680_sample_t *sample, uint16_t len, uint16_t *count)
+{
+    uint8_t res;
+    uint16_t i;
+
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (((mask & BME680_OUTPUT_ALL) == 0) || ((mask & ~BME680_OUTPUT_ALL) != 0))           /* check mask */
+    {
+        handle->debug_print("bme680: mask is invalid.\n");                                 /* mask is invalid */
+
+        return 8;                                                                          /* return error */
+    }
+
+    *count = 0;                                                                            /* no sample yet */
+    for (i = 0; i < len; i++)                                                              /* read each sample */
+    {
+        if (a_bme680_bus_lock(handle) != 0)                                                /* lock the bus */
+        {
+            return 1;                                                                      /* return error */
+        }
+        res = a_bme680_read_sample(handle, mask, &sample[i]);                              /* read the sample */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+        if (res != 0)                                                                      /* check result */
+        {
+            return res;                                                                    /* return error */
+        }
+        *count = i + 1;                                                                    /* count the sample */
+    }
+
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     start the free running mode
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] mask output mask, the or of bme680_output_t
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 8 mask is invalid
+ * @note      the chip has no continuous mode, the driver triggers the first forced conversion here
+ *            and bme680_read_continuous triggers the next one right after each readout
+ */
+uint8_t bme680_start_continuous(bme680_handle_t *handle, uint8_t mask)
+{
+    uint8_t prev;
+
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    if (((mask & BME680_OUTPUT_ALL) == 0) || ((mask & ~BME680_OUTPUT_ALL) != 0))        /* check mask */
+    {
+        handle->debug_print("bme680: mask is invalid.\n");                              /* mask is invalid */
+
+        return 8;                                                                       /* return error */
+    }
+
+    if (a_bme680_bus_lock(handle) != 0)                                                 /* lock the bus */
+    {
+        return 1;                                                                       /* return error */
+    }
+    if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)             /* read ctrl meas */
+    {
+        handle->debug_print("bme680: read ctrl meas failed.\n");                        /* read ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                              /* unlock the bus */
+
+        return 1;                                                                       /* return error */
+    }
+    prev &= ~(3 << 0);                                                                  /* clear settings */
+    prev |= 0x01 << 0;                                                                  /* set forced mode */
+    if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)            /* write ctrl meas */
+    {
+        handle->debug_print("bme680: write ctrl meas failed.\n");                       /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                              /* unlock the bus */
+
+        return 1;                                                                       /* return error */
+    }
+    handle->continuous_ctrl_meas = prev;                                                /* save ctrl meas */
+    handle->continuous_mask = mask;                                                     /* save mask */
+    handle->continuous = 1;                                                             /* set continuous flag */
+    (void)a_bme680_bus_unlock(handle);                                                  /* unlock the bus */
+
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      read one sample in the free running mode
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 read timeout or data is not ready
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ *             - 9 free running mode is not started
+ * @note       it waits for the running conversion, reads the raw registers in one burst, applies the ambient
+ *             feedback, triggers the next conversion and then compensates the rest of the frame while the chip is converting,
+ *             a frame without the new data flag is dropped with 5,
+ *             call it after bme680_get_measurement_duration's time to avoid the polling
+ */
+uint8_t bme680_read_continuous(bme680_handle_t *handle, bme680_sample_t *sample)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t mask;
+    uint8_t len;
+    uint8_t flag;
+    uint32_t timeout;
+    uint8_t buf[15];
+
+    if (handle == NULL)                                                                                             /* check handle */
+    {
+        return 2;                                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                                   /* return error */
+    }
+    if (handle->continuous != 1)                                                                                    /* check continuous */
+    {
+        handle->debug_print("bme680: free running mode is not started.\n");                                         /* free running mode is not started */
+
+        return 9;                                                                                                   /* return error */
+    }
+
+    if (a_bme680_bus_lock(handle) != 0)                                                                             /* lock the bus */
+    {
+        return 1;                                                                                                   /* return error */
+    }
+    timeout = a_bme680_conversion_timeout(handle);                                                                  /* set timeout */
+    while (timeout != 0)                                                                                            /* check timeout */
+    {
+        if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                                     /* read ctrl meas */
+        {
+            handle->debug_print("bme680: read ctrl meas failed.\n");                                                /* read ctrl meas failed */
+            (void)a_bme680_bus_unlock(handle);                                                                      /* unlock the bus */
+
+            return 1;                                                                                               /* return error */
+        }
+        if ((prev & 0x03) == 0)                                                                                     /* if finished */
+        {
+            break;                                                                                                  /* break */
+        }
+        handle->delay_ms(1);                                                                                        /* delay 1ms */
+        timeout--;                                                                                                  /* timeout-- */
+    }
+    if (timeout == 0)                                                                                               /* check timeout */
+    {
+        handle->debug_print("bme680: read timeout.\n");                                                             /* read timeout */
+        (void)a_bme680_bus_unlock(handle);                                                                          /* unlock the bus */
+
+        return 5;                                                                                                   /* return error */
+    }
+    mask = handle->continuous_mask;                                                                                 /* get output mask */
+    len = ((mask & BME680_OUTPUT_GAS) != 0) ? 15 : 10;                                                              /* skip gas registers */
+    res = a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, buf, len);                                          /* read status and data in one burst */
+    if (res != 0)
+    {
+        handle->debug_print("bme680: read failed.\n");                                                              /* read failed */
+        (void)a_bme680_bus_unlock(handle);                                                                          /* unlock the bus */
+
+        return 1;                                                                                                   /* return error */
+    }
+    if (((buf[0] & (1 << 7)) != 0) &&
+        ((mask & (BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY)) != 0))              /* new temperature pressure or humidity */
+    {
+        sample->temperature_raw = ((((uint32_t)(buf[5])) << 12) |
+                                  (((uint32_t)(buf[6])) << 4) |
+                                  ((uint32_t)buf[7] >> 4));                                                         /* set temperature raw */
+        res = a_bme680_compensate_temperature(handle, sample->temperature_raw, &sample->temperature_c);             /* compensate temperature */
+        if (res != 0)
+        {
+            handle->debug_print("bme680: compensate temperature failed.\n");                                        /* compensate temperature failed */
+            (void)a_bme680_bus_unlock(handle);                                                                      /* unlock the bus */
+
+            return 4;                                                                                               /* return error */
+        }
+        if (a_bme680_ambient_feedback(handle, sample->temperature_c) != 0)                                          /* ambient feedback */
+        {
+            (void)a_bme680_bus_unlock(handle);                                                                      /* unlock the bus */
+
+            return 1;                                                                                               /* return error */
+        }
+    }
+    prev = handle->continuous_ctrl_meas;                                                                            /* get forced mode settings */
+    if (a_bme680_iic_spi_write(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)                                        /* trigger the next conversion */
+    {
+        handle->debug_print("bme680: write ctrl meas failed.\n");                                                   /* write ctrl meas failed */
+        (void)a_bme680_bus_unlock(handle);                                                                          /* unlock the bus */
+
+        return 1;                                                                                                   /* return error */
+    }
+    if ((buf[0] & (1 << 7)) == 0)                                                                                   /* check new data */
+    {
+        handle->debug_print("bme680: data is not ready.\n");                                                        /* data is not ready */
+        (void)a_bme680_bus_unlock(handle);                                                                          /* unlock the bus */
+
+        return 5;                                                                                                   /* return error */
+    }
+    sample->timestamp_ms = (handle->get_time_ms != NULL) ? handle->get_time_ms() : 0;                               /* set timestamp */
+    sample->mask = 0;                                                                                               /* clear valid outputs */
+    sample->status = 0;                                                                                             /* clear status */
+    flag = 0;                                                                                                       /* init cache flag */
+    if ((mask & (BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY)) != 0)                /* temperature pressure or humidity */
+    {
+        handle->cache_temperature_raw = sample->temperature_raw;                                                    /* save temperature raw */
+        handle->cache_temperature_c = sample->temperature_c;                                                        /* save temperature */
+        flag |= BME680_CACHE_TEMPERATURE;                                                                           /* temperature is cached */
+        sample->mask |= mask & BME680_OUTPUT_TEMPERATURE;                                                           /* temperature is valid */
+        if ((mask & BME680_OUTPUT_PRESSURE) != 0)                                                                   /* check pressure */
+        {
+            sample->pressure_raw = ((((uint32_t)(buf[2])) << 12) |
+                                   (((uint32_t)(buf[3])) << 4) |
+                                   (((uint32_t)(buf[4])) >> 4));                                                    /* set pressure raw */
+            res = a_bme680_compensate_pressure(handle, sample->pressure_raw, &sample->pressure_pa);                 /* compensate pressure */
+            if (res != 0)
+            {
+                handle->debug_print("bme680: compensate pressure failed.\n");                                       /* compensate pressure failed */
+                (void)a_bme680_bus_unlock(handle);                                                                  /* unlock the bus */
+
+                return 4;                                                                                           /* return error */
+            }
+            handle->cache_pressure_raw = sample->pressure_raw;                                                      /* save pressure raw */
+            handle->cache_pressure_pa = sample->pressure_pa;                                                        /* save pressure */
+            flag |= BME680_CACHE_PRESSURE;                                                                          /* pressure is cached */
+            sample->mask |= BME680_OUTPUT_PRESSURE;                                                                 /* pressure is valid */
+        }
+        if ((mask & BME680_OUTPUT_HUMIDITY) != 0)                                                                   /* check humidity */
+        {
+            sample->humidity_raw = ((uint32_t)buf[8] << 8) | buf[9];                                                /* set humidity raw */
+            res = a_bme680_compensate_humidity(handle, sample->humidity_raw, &sample->humidity_percentage);         /* compensate humidity */
+            if (res != 0)
+            {
+                handle->debug_print("bme680: compensate humidity failed.\n");                                       /* compensate humidity failed */
+                (void)a_bme680_bus_unlock(handle);                                                                  /* unlock the bus */
+
+                return 4;                                                                                           /* return error */
+            }
+            handle->cache_humidity_raw = sample->humidity_raw;                                                      /* save humidity raw */
+            handle->cache_humidity_percentage = sample->humidity_percentage;                                        /* save humidity */
+            flag |= BME680_CACHE_HUMIDITY;                                                                          /* humidity is cached */
+            sample->mask |= BME680_OUTPUT_HUMIDITY;                                                                 /* humidity is valid */
+        }
+    }
+    if (flag != 0)                                                                                                  /* check cache flag */
+    {
+        a_bme680_cache_save(handle, flag);                                                                          /* save the cache */
+    }
+    if ((mask & BME680_OUTPUT_GAS) != 0)                                                                            /* check gas */
+    {
+        if ((buf[14] & (1 << 5)) != 0)                                                                              /* check gas valid */
+        {
+            sample->status |= BME680_SAMPLE_STATUS_GAS_VALID;                                                       /* gas is valid */
+        }
+        if ((buf[14] & (1 << 4)) != 0)                                                                              /* check heat */
+        {
+            sample->status |= BME680_SAMPLE_STATUS_HEATER_STABLE;                                                   /* heater is stable */
+        }
+        if ((sample->status & BME680_SAMPLE_STATUS_GAS_VALID) == 0)                                                 /* check gas valid */
+        {
+            handle->debug_print("bme680: gas is invalid.\n");                                                       /* gas is invalid */
+            (void)a_bme680_bus_unlock(handle);                                                                      /* unlock the bus */
+
+            return 6;                                                                                               /* return error */
+        }
+        if ((sample->status & BME680_SAMPLE_STATUS_HEATER_STABLE) == 0)                                             /* check heat */
+        {
+            handle->debug_print("bme680: heater is not stable.\n");                                                 /* heater is not stable */
+            (void)a_bme680_bus_unlock(handle);                                                                      /* unlock the bus */
+
+            return 7;                                                                                               /* return error */
+        }
+        sample->adc_raw = (((uint16_t)buf[13]) << 2) | ((buf[14] >> 6) & 0x03);                                     /* set adc raw */
+        sample->adc_range = buf[14] & 0x0F;                                                                         /* set adc range */
+        res = a_bme680_compensate_gas_resistance(handle, sample->adc_raw, sample->adc_range, &sample->ohms);        /* compensate gas resistance */
+        if (res != 0)                                                                                               /* check result */
+        {
+            handle->debug_print("bme680: compensate gas resistance failed.\n");                                     /* compensate gas resistance failed */
+            (void)a_bme680_bus_unlock(handle);                                                                      /* unlock the bus */
+
+            return 4;                                                                                               /* return error */
+        }
+        sample->index = buf[0] & 0xF;                                                                               /* set index */
+        sample->mask |= BME680_OUTPUT_GAS;                                                                          /* gas is valid */
+    }
+    (void)a_bme680_bus_unlock(handle);                                                                              /* unlock the bus */
+
+    return 0;                                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     stop the free running mode
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 read timeout
+ * @note      it waits for the running conversion so the chip is in the sleep mode after this
+ */
+uint8_t bme680_stop_continuous(bme680_handle_t *handle)
+{
+    uint8_t prev;
+    uint32_t timeout;
+
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
+    }
+
+    if (handle->continuous != 1)                                                       /* check continuous */
+    {
+        return 0;                                                                      /* already stopped */
+    }
+    if (a_bme680_bus_lock(handle) != 0)                                                /* lock the bus */
+    {
+        return 1;                                                                      /* return error */
+    }
+    timeout = a_bme680_conversion_timeout(handle);                                     /* set timeout */
+    while (timeout != 0)                                                               /* check timeout */
+    {
+        if (a_bme680_iic_spi_read(handle, BME680_REG_CTRL_MEAS, &prev, 1) != 0)        /* read ctrl meas */
+        {
+            handle->debug_print("bme680: read ctrl meas failed.\n");                   /* read ctrl meas failed */
+            (void)a_bme680_bus_unlock(handle);                                         /* unlock the bus */
+
+            return 1;                                                                  /* return error */
+        }
+        if ((prev & 0x03) == 0)                                                        /* if finished */
+        {
+            break;                                                                     /* break */
+        }
+        handle->delay_ms(1);                                                           /* delay 1ms */
+        timeout--;                                                                     /* timeout-- */
+    }
+    if (timeout == 0)                                                                  /* check timeout */
+    {
+        handle->debug_print("bme680: read timeout.\n");                                /* read timeout */
+        (void)a_bme680_bus_unlock(handle);                                             /* unlock the bus */
+
+        return 5;                                                                      /* return error */
+    }
+    handle->continuous = 0;                                                            /* clear continuous flag */
+    (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the expected measurement duration of one forced conversion
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *us pointer to a duration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get measurement duration failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the duration is calculated from the current oversampling, run gas, convert index and gas wait settings
+ */
+uint8_t bme680_get_measurement_duration(bme680_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    if (handle->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                              /* return error */
+    }
+
+    if (a_bme680_bus_lock(handle) != 0)                        /* lock the bus */
+    {
+        return 1;                                              /* return error */
+    }
+    if (a_bme680_measurement_duration(handle, us) != 0)        /* calculate the duration */
+    {
+        (void)a_bme680_bus_unlock(handle);                     /* unlock the bus */
+
+        return 1;                                              /* return error */
+    }
+    (void)a_bme680_bus_unlock(handle);                         /* unlock the bus */
+
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the temperature pressure humidity of the finished conversion
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a converted pressure buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_percentage pointer to a converted humidity percentage buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 data is not ready
+ * @note       this function doesn't start a conversion and doesn't wait,
+ *             start the conversion with bme680_set_mode(handle, BME680_MODE_FORCED) and
+ *             call this function after bme680_get_measurement_duration's time
+ */
+uint8_t bme680_get_temperature_pressure_humidity(bme680_handle_t *handle, uint32_t *temperature_raw, float *temperature_c,
+                                                 uint32_t *pressure_raw, float *pressure_pa,
+                                                 uint32_t *humidity_raw, float *humidity_percentage)
+{
+    uint8_t res;
+    uint8_t buf[10];
+
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+
+    if (a_bme680_bus_lock(handle) != 0)                                                    /* lock the bus */
+    {
+        return 1;                                                                          /* return error */
+    }
+    res = a_bme680_iic_spi_read(handle, BME680_REG_MEAS_STATUS, buf, 10);                  /* read status temperature pressure and humidity */
+    if (res != 0)
+    {
+        handle->debug_print("bme680: read failed.\n");                                     /* read failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 1;                                                                          /* return error */
+    }
+    if ((buf[0] & (1 << 7)) == 0)                                                          /* check new data */
+    {
+        handle->debug_print("bme680: data is not ready.\n");                               /* data is not ready */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 5;                                                                          /* return error */
+    }
+    *temperature_raw = ((((uint32_t)(buf[5])) << 12) |
+                       (((uint32_t)(buf[6])) << 4) |
+                       ((uint32_t)buf[7] >> 4));                                           /* set temperature raw */
+    res = a_bme680_compensate_temperature(handle, *temperature_raw, temperature_c);        /* compensate temperature */
+    if (res != 0)
+    {
+        handle->debug_print("bme680: compensate temperature failed.\n");                   /* compensate temperature failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 4;                                                                          /* return error */
+    }
+    if (a_bme680_ambient_feedback(handle, *temperature_c) != 0)                            /* ambient feedback */
+    {
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 1;                                                                          /* return error */
+    }
+    *pressure_raw = ((((uint32_t)(buf[2])) << 12) |
+                    (((uint32_t)(buf[3])) << 4) |
+                    (((uint32_t)(buf[4])) >> 4));                                          /* set pressure raw */
+    res = a_bme680_compensate_pressure(handle, *pressure_raw, pressure_pa);                /* compensate pressure */
+    if (res != 0)
+    {
+        handle->debug_print("bme680: compensate pressure failed.\n");                      /* compensate pressure failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 4;                                                                          /* return error */
+    }
+    *humidity_raw = (uint32_t)buf[8] << 8 | buf[9];                                        /* set humidity raw */
+    res = a_bme680_compensate_humidity(handle, *humidity_raw, humidity_percentage);        /* compensate humidity */
+    if (res != 0)
+    {
+        handle->debug_print("bme680: compensate humidity failed.\n");                      /* compensate humidity failed */
+        (void)a_bme680_bus_unlock(handle);                                                 /* unlock the bus */
+
+        return 4;                                                                          /* return error */
+    }
+    handle->cache_temperature_raw = *temperature_raw;                                      /* save temperature raw */
+    handle->cache_temperature_c = *temperature_c;                                          /* save temperature */
+    handle->cache_pressure_raw = *pressure_raw;                                            /* save pressure raw */
+    handle->cache_pressure_pa = *pressure_pa;                                              /* save pressure */
+    handle->cache_humidity_raw = *humidity_raw;                                            /* save humidity raw */
+    handle->cache_humidity_percentage = *humidity_percentage;                              /* save humidity */
+    a_bme680_cache_save(handle, BME680_CACHE_ALL);                                         /* save the cache */
+    (void)a_bme680_bus_unlock(handle);                                                     /* unlock the bus */
+
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the sample cache max age
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] ms max age in ms and 0 means disable
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_time_ms is null
+ * @note      every finished conversion saves its sample, bme680_read_temperature, bme680_read_pressure and
+ *            bme680_read_humidity return the saved values without bus traffic while the sample is younger than ms,
+ *            the oversampling, filter, mode and raw register setters drop the saved sample
+ */
+uint8_t bme680_set_cache_max_age(bme680_handle_t *handle, uint32_t ms)
+{
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+    if ((ms != 0) && (handle->get_time_ms == NULL))                     /* check get_time_ms */
+    {
+        handle->debug_print("bme680: get_time_ms is null.\n");          /* get_time_ms is null */
+
+        return 4;                                                       /* return error */
+    }
+
+    handle->cache_max_age_ms = ms;                                      /* set max age */
+    handle->cache_valid = 0;                                            /* clear the cache */
+
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the sample cache max age
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *ms pointer to a max age buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bme680_get_cache_max_age(bme680_handle_t *handle, uint32_t *ms)
+{
+    if (handle == NULL)                                                 /* check handle */
+    {
+        return 2;                                                       /* return error */
+    }
+    if (handle->inited != 1)                                            /* check handle initialization */
+    {
+        return 3;                                                       /* return error */
+    }
+
+    *ms = handle->cache_max_age_ms;                                     /* get max age */
+
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the ambient temperature feedback
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] threshold drift threshold in degree c and 0 means disable
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled every compensated temperature is compared with the ambient temperature of the heater formula,
+ *            once the drift reaches threshold the ambient temperature is updated and the heater registers set by
+ *            bme680_set_heater_temperature are recomputed and rewritten,
+ *            the free running mode rewrites them before it triggers the next conversion
+ */
+uint8_t bme680_set_ambient_feedback(bme680_handle_t *handle, uint8_t threshold)
+{
+    if (handle == NULL)                       /* check handle */
+    {
+        return 2;                             /* return error */
+    }
+    if (handle->inited != 1)                  /* check handle initialization */
+    {
+        return 3;                             /* return error */
+    }
+
+    handle->amb_threshold = threshold;        /* set threshold */
+
+    return 0;                                 /* success return 0 */
+}
+
+/**
+ * @brief      get the ambient temperature feedback
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *threshold pointer to a drift threshold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bme680_get_ambient_feedback(bme680_handle_t *handle, uint8_t *threshold)
+{
+    if (handle == NULL)                        /* check handle */
+    {
+        return 2;                              /* return error */
+    }
+    if (handle->inited != 1)                   /* check handle initialization */
+    {
+        return 3;                              /* return error */
+    }
+
+    *threshold = handle->amb_threshold;        /* get threshold */
+
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief     set the bus retry policy
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] times retry times of one failed transaction, 0 means disable and the max is 16
+ * @param[in] backoff_ms first backoff in ms, doubled after every retry
+ * @param[in] budget_ms max total backoff of one transaction in ms and 0 means no limit
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 times is over 16
+ * @note      only the failed register transaction is repeated, so a finished conversion is not thrown away,
+ *            the bus stays locked during the backoff
+ */
+uint8_t bme680_set_retry(bme680_handle_t *handle, uint8_t times, uint16_t backoff_ms, uint32_t budget_ms)
+{
+    if (handle == NULL)                                            /* check handle */
+    {
+        return 2;                                                  /* return error */
+    }
+    if (handle->inited != 1)                                       /* check handle initialization */
+    {
+        return 3;                                                  /* return error */
+    }
+    if (times > 16)                                                /* check times */
+    {
+        handle->debug_print("bme680: times is over 16.\n");        /* times is over 16 */
+
+        return 4;                                                  /* return error */
+    }
+
+    handle->retry_times = times;                                   /* set times */
+    handle->retry_backoff_ms = backoff_ms;                         /* set backoff */
+    handle->retry_budget_ms = budget_ms;                           /* set budget */
+
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the bus retry policy
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *times pointer to a retry times buffer
+ * @param[out] *backoff_ms pointer to a first backoff buffer
+ * @param[out] *budget_ms pointer to a max total backoff buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bme680_get_retry(bme680_handle_t *handle, uint8_t *times, uint16_t *backoff_ms, uint32_t *budget_ms)
+{
+    if (handle == NULL)                            /* check handle */
+    {
+        return 2;                                  /* return error */
+    }
+    if (handle->inited != 1)                       /* check handle initialization */
+    {
+        return 3;                                  /* return error */
+    }
+
+    *times = handle->retry_times;                  /* get times */
+    *backoff_ms = handle->retry_backoff_ms;        /* get backoff */
+    *budget_ms = handle->retry_budget_ms;          /* get budget */
+
+    return 0;                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the bus retry statistics
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *retries pointer to a retry counter buffer
+ * @param[out] *failed pointer to a failed transaction counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the counters run since the initialization or the last bme680_clear_retry_statistics
+ */
+uint8_t bme680_get_retry_statistics(bme680_handle_t *handle, uint32_t *retries, uint32_t *failed)
+{
+    if (handle == NULL)                    /* check handle */
+    {
+        return 2;                          /* return error */
+    }
+    if (handle->inited != 1)               /* check handle initialization */
+    {
+        return 3;                          /* return error */
+    }
+
+    *retries = handle->retry_count;        /* get retries */
+    *failed = handle->retry_failed;        /* get failed transactions */
+
+    return 0;                              /* success return 0 */
+}
+
+/**
+ * @brief     clear the bus retry statistics
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bme680_clear_retry_statistics(bme680_handle_t *handle)
+{
+    if (handle == NULL)              /* check handle */
+    {
+        return 2;                    /* return error */
+    }
+    if (handle->inited != 1)         /* check handle initialization */
+    {
+        return 3;                    /* return error */
+    }
+
+    handle->retry_count = 0;         /* clear retries */
+    handle->retry_failed = 0;        /* clear failed transactions */
+
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief     set the conversion timeout margin
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] ms timeout margin in ms and 0 means the fixed 10s timeout
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the conversion timeout is the expected measurement duration plus the margin,
+ *            so a stuck chip returns the read timeout soon after its conversion should have finished
+ */
+uint8_t bme680_set_timeout_margin(bme680_handle_t *handle, uint16_t ms)
+{
+    if (handle == NULL)                    /* check handle */
+    {
+        return 2;                          /* return error */
+    }
+    if (handle->inited != 1)               /* check handle initialization */
+    {
+        return 3;                          /* return error */
+    }
+
+    handle->timeout_margin_ms = ms;        /* set margin */
+
+    return 0;                              /* success return 0 */
+}
+
+/**
+ * @brief      get the conversion timeout margin
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *ms pointer to a timeout margin buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bme680_get_timeout_margin(bme680_handle_t *handle, uint16_t *ms)
+{
+    if (handle == NULL)                     /* check handle */
+    {
+        return 2;                           /* return error */
+    }
+    if (handle->inited != 1)                /* check handle initialization */
+    {
+        return 3;                           /* return error */
+    }
+
+    *ms = handle->timeout_margin_ms;        /* get margin */
+
+    return 0;                               /* success return 0 */
+}
+
+/**
+ * @brief     set the heater temperature of one index
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] index input index
+ * @param[in] degree_celsius heater temperature in degree c
+ * @return    status code
+ *            - 0 success
+ *            - 1 set heater temperature failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 index > 9
+ * @note      the register is computed with the current ambient temperature and the target is kept
+ *            so the ambient temperature feedback can recompute it
+ */
+uint8_t bme680_set_heater_temperature(bme680_handle_t *handle, uint8_t index, float degree_celsius)
+{
+    uint8_t reg;
+
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (index > 9)                                                                          /* check index */
+    {
+        handle->debug_print("bme680: index > 9.\n");                                        /* index > 9 */
+
+        return 4;                                                                           /* return error */
+    }
+
+    if (a_bme680_bus_lock(handle) != 0)                                                     /* lock the bus */
+    {
+        return 1;                                                                           /* return error */
+    }
+    (void)a_bme680_compensate_heat(handle, degree_celsius, &reg);                           /* compute register */
+    if (a_bme680_iic_spi_write(handle, BME680_REG_RES_HEAT_X + index, &reg, 1) != 0)        /* write resistance heater */
+    {
+        handle->debug_print("bme680: write resistance heater failed.\n");                   /* write resistance heater failed */
+        (void)a_bme680_bus_unlock(handle);                                                  /* unlock the bus */
+
+        return 1;                                                                           /* return error */
+    }
+    handle->heat_target_c[index] = degree_celsius;                                          /* save target */
+    handle->heat_target_mask |= (uint16_t)(1 << index);                                     /* set target flag */
+    (void)a_bme680_bus_unlock(handle);                                                      /* unlock the bus */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the chip register
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
 uint8_t bme680_set_reg(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    uint8_t res;
+
     if (handle == NULL)                                         /* check handle */
     {
         return 2;                                               /* return error */
@@ -3018,7 +5248,15 @@ uint8_t bme680_set_reg(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
         return 3;                                               /* return error */
     }
 
-    return a_bme680_iic_spi_write(handle, reg, buf, len);       /* write register */
+    if (a_bme680_bus_lock(handle) != 0)                         /* lock the bus */
+    {
+        return 1;                                               /* return error */
+    }
+    res = a_bme680_iic_spi_write(handle, reg, buf, len);        /* write register */
+    handle->cache_valid = 0;                                    /* drop the cached sample */
+    (void)a_bme680_bus_unlock(handle);                          /* unlock the bus */
+
+    return res;                                                 /* return the result */
 }
 
 /**
@@ -3036,6 +5274,8 @@ uint8_t bme680_set_reg(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t bme680_get_reg(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    uint8_t res;
+
     if (handle == NULL)                                        /* check handle */
     {
         return 2;                                              /* return error */
@@ -3045,7 +5285,14 @@ uint8_t bme680_get_reg(bme680_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
         return 3;                                              /* return error */
     }
 
-    return a_bme680_iic_spi_read(handle, reg, buf, len);       /* read register */
+    if (a_bme680_bus_lock(handle) != 0)                        /* lock the bus */
+    {
+        return 1;                                              /* return error */
+    }
+    res = a_bme680_iic_spi_read(handle, reg, buf, len);        /* read register */
+    (void)a_bme680_bus_unlock(handle);                         /* unlock the bus */
+
+    return res;                                                /* return the result */
 }
 
 /**
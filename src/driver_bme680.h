@@ -129,6 +129,47 @@ typedef enum
     BME680_SPI_WIRE_3 = 0x01,        /**< 3 wire */
 } bme680_spi_wire_t;
 
+/**
+ * @brief bme680 output enumeration definition
+ */
+typedef enum
+{
+    BME680_OUTPUT_TEMPERATURE = (1 << 0),        /**< temperature output */
+    BME680_OUTPUT_PRESSURE    = (1 << 1),        /**< pressure output */
+    BME680_OUTPUT_HUMIDITY    = (1 << 2),        /**< humidity output */
+    BME680_OUTPUT_GAS         = (1 << 3),        /**< gas resistance output */
+    BME680_OUTPUT_ALL         = 0x0F,            /**< all outputs */
+} bme680_output_t;
+
+/**
+ * @brief bme680 sample status enumeration definition
+ */
+typedef enum
+{
+    BME680_SAMPLE_STATUS_GAS_VALID     = (1 << 0),        /**< gas resistance is valid */
+    BME680_SAMPLE_STATUS_HEATER_STABLE = (1 << 1),        /**< heater is stable */
+} bme680_sample_status_t;
+
+/**
+ * @brief bme680 sample structure definition
+ */
+typedef struct bme680_sample_s
+{
+    uint32_t timestamp_ms;              /**< sample time in ms and 0 if get_time_ms is not linked */
+    uint8_t mask;                       /**< valid outputs, the or of bme680_output_t */
+    uint8_t status;                     /**< status flags, the or of bme680_sample_status_t */
+    uint32_t temperature_raw;           /**< raw temperature */
+    float temperature_c;                /**< converted temperature */
+    uint32_t pressure_raw;              /**< raw pressure */
+    float pressure_pa;                  /**< converted pressure */
+    uint32_t humidity_raw;              /**< raw humidity */
+    float humidity_percentage;          /**< converted humidity percentage */
+    uint16_t adc_raw;                   /**< gas adc raw */
+    uint8_t adc_range;                  /**< gas adc range */
+    uint8_t index;                      /**< heater index */
+    float ohms;                         /**< gas resistance */
+} bme680_sample_t;
+
 /**
  * @brief bme680 handle structure definition
  */
@@ -145,6 +186,9 @@ typedef struct bme680_handle_s
     uint8_t (*spi_write)(uint8_t reg, uint8_t *buf, uint16_t len);                      /**< point to a spi_write function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
+    uint8_t (*bus_lock)(struct bme680_handle_s *handle);                                /**< point to a bus_lock function address */
+    uint8_t (*bus_unlock)(struct bme680_handle_s *handle);                              /**< point to a bus_unlock function address */
+    uint32_t (*get_time_ms)(void);                                                      /**< point to a get_time_ms function address */
     uint8_t inited;                                                                     /**< inited flag */
     uint8_t iic_spi;                                                                    /**< iic spi interface */
     uint8_t page;                                                                       /**< spi page */
@@ -176,6 +220,31 @@ typedef struct bme680_handle_s
     int8_t range_sw_err;                                                                /**< gas resistance range switching error coefficient */
     int8_t amb_temp;                                                                    /**< ambient temperature in degree c */
     float t_fine;                                                                       /**< variable to store the intermediate temperature coefficient */
+    uint8_t amb_threshold;                                                              /**< ambient feedback threshold in degree c */
+    uint16_t heat_target_mask;                                                          /**< heater target set flags */
+    float heat_target_c[10];                                                            /**< heater target temperatures */
+    uint8_t continuous;                                                                 /**< free running flag */
+    uint8_t continuous_mask;                                                            /**< free running output mask */
+    uint8_t continuous_ctrl_meas;                                                       /**< free running ctrl meas */
+    uint32_t cache_max_age_ms;                                                          /**< cache max age in ms */
+    uint32_t cache_time_ms;                                                             /**< cache sample time in ms */
+    uint32_t reset_time_ms;                                                             /**< soft reset time in ms */
+    uint8_t config_cache[38];                                                           /**< cached registers from 0x50 to 0x75 */
+    uint8_t config_valid;                                                               /**< configuration cache valid flag */
+    uint16_t calibration_checksum;                                                      /**< calibration coefficients checksum */
+    uint8_t retry_times;                                                                /**< retry times of one transaction */
+    uint16_t retry_backoff_ms;                                                          /**< first retry backoff in ms */
+    uint32_t retry_budget_ms;                                                           /**< max total backoff of one transaction in ms */
+    uint32_t retry_count;                                                               /**< retry counter */
+    uint32_t retry_failed;                                                              /**< failed transaction counter */
+    uint16_t timeout_margin_ms;                                                         /**< conversion timeout margin in ms */
+    uint8_t cache_valid;                                                                /**< cache valid flag */
+    uint32_t cache_temperature_raw;                                                     /**< cache raw temperature */
+    float cache_temperature_c;                                                          /**< cache converted temperature */
+    uint32_t cache_pressure_raw;                                                        /**< cache raw pressure */
+    float cache_pressure_pa;                                                            /**< cache converted pressure */
+    uint32_t cache_humidity_raw;                                                        /**< cache raw humidity */
+    float cache_humidity_percentage;                                                    /**< cache converted humidity */
 } bme680_handle_t;
 
 /**
@@ -293,6 +362,32 @@ typedef struct bme680_info_s
  */
 #define DRIVER_BME680_LINK_DEBUG_PRINT(HANDLE, FUC)        (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link bus_lock function
+ * @param[in] HANDLE pointer to a bme680 handle structure
+ * @param[in] FUC pointer to a bus_lock function address
+ * @note      optional, the lock is taken once around each driver api call and
+ *            is held across the conversion wait, NULL disables the bus locking,
+ *            the handle is passed so the port can keep one lock per bus
+ */
+#define DRIVER_BME680_LINK_BUS_LOCK(HANDLE, FUC)           (HANDLE)->bus_lock = FUC
+
+/**
+ * @brief     link bus_unlock function
+ * @param[in] HANDLE pointer to a bme680 handle structure
+ * @param[in] FUC pointer to a bus_unlock function address
+ * @note      optional, must be linked together with the bus_lock function
+ */
+#define DRIVER_BME680_LINK_BUS_UNLOCK(HANDLE, FUC)         (HANDLE)->bus_unlock = FUC
+
+/**
+ * @brief     link get_time_ms function
+ * @param[in] HANDLE pointer to a bme680 handle structure
+ * @param[in] FUC pointer to a get_time_ms function address
+ * @note      optional, it is only used by the sample cache
+ */
+#define DRIVER_BME680_LINK_GET_TIME_MS(HANDLE, FUC)        (HANDLE)->get_time_ms = FUC
+
 /**
  * @}
  */
@@ -373,6 +468,34 @@ uint8_t bme680_get_addr_pin(bme680_handle_t *handle, bme680_address_t *addr_pin)
  */
 uint8_t bme680_init(bme680_handle_t *handle);
 
+/**
+ * @brief     start the chip initialization
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is error
+ *            - 5 reset failed
+ * @note      it checks the id and resets the chip without waiting for the reset,
+ *            call bme680_init_finish to complete the initialization
+ */
+uint8_t bme680_init_start(bme680_handle_t *handle);
+
+/**
+ * @brief     finish the chip initialization
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 bus lock, get nvm calibration or configuration failed
+ *            - 2 handle is NULL
+ *            - 3 initialization is not started
+ * @note      it waits for the rest of the 5ms reset time and reads the calibration,
+ *            the bus is closed if it fails
+ */
+uint8_t bme680_init_finish(bme680_handle_t *handle);
+
 /**
  * @brief     close the chip
  * @param[in] *handle pointer to a bme680 handle structure
@@ -408,13 +531,138 @@ uint8_t bme680_deinit(bme680_handle_t *handle);
  *             - 5 read timeout
  *             - 6 gas is invalid
  *             - 7 heater is not stable
- * @note       none
+ * @note       it is bme680_read_sample with all outputs,
+ *             the temperature pressure and humidity are still set when it fails with 6 or 7
  */
 uint8_t bme680_read(bme680_handle_t *handle, uint32_t *temperature_raw, float *temperature_c,
                     uint32_t *pressure_raw, float *pressure_pa,
                     uint32_t *humidity_raw, float *humidity_percentage,
                     uint16_t *adc_raw, uint8_t *adc_range, float *ohms, uint8_t *index);
 
+/**
+ * @brief      read the selected outputs
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  mask output mask, the or of bme680_output_t
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a converted pressure buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_percentage pointer to a converted humidity percentage buffer
+ * @param[out] *adc_raw pointer to an adc raw buffer
+ * @param[out] *adc_range pointer to an adc range buffer
+ * @param[out] *ohms pointer to an ohms buffer
+ * @param[out] *index pointer to a heater index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 read timeout
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ *             - 8 mask is invalid
+ * @note       the buffers of the unselected outputs are not used and can be NULL,
+ *             the compensation of the unselected outputs and the gas registers read are skipped,
+ *             the temperature is still compensated internally when pressure or humidity is selected
+ */
+uint8_t bme680_read_selective(bme680_handle_t *handle, uint8_t mask,
+                              uint32_t *temperature_raw, float *temperature_c,
+                              uint32_t *pressure_raw, float *pressure_pa,
+                              uint32_t *humidity_raw, float *humidity_percentage,
+                              uint16_t *adc_raw, uint8_t *adc_range, float *ohms, uint8_t *index);
+
+/**
+ * @brief      read one sample
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  mask output mask, the or of bme680_output_t
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 read timeout
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ *             - 8 mask is invalid
+ * @note       sample->mask holds the outputs which are valid, it is also set when 6 or 7 is returned
+ */
+uint8_t bme680_read_sample(bme680_handle_t *handle, uint8_t mask, bme680_sample_t *sample);
+
+/**
+ * @brief      read a batch of samples
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[in]  mask output mask, the or of bme680_output_t
+ * @param[out] *sample pointer to a sample array
+ * @param[in]  len sample array length
+ * @param[out] *count pointer to a filled sample count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 read timeout
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ *             - 8 mask is invalid
+ * @note       the forced conversions run back to back and the bus is locked for each one,
+ *             it stops at the first failed sample and count is the number of the valid samples before it
+ */
+uint8_t bme680_read_samples(bme680_handle_t *handle, uint8_t mask, bme680_sample_t *sample, uint16_t len, uint16_t *count);
+
+/**
+ * @brief     start the free running mode
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] mask output mask, the or of bme680_output_t
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 8 mask is invalid
+ * @note      the chip has no continuous mode, the driver triggers the first forced conversion here
+ *            and bme680_read_continuous triggers the next one right after each readout
+ */
+uint8_t bme680_start_continuous(bme680_handle_t *handle, uint8_t mask);
+
+/**
+ * @brief      read one sample in the free running mode
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 read timeout or data is not ready
+ *             - 6 gas is invalid
+ *             - 7 heater is not stable
+ *             - 9 free running mode is not started
+ * @note       it waits for the running conversion, reads the raw registers in one burst, applies the ambient
+ *             feedback, triggers the next conversion and then compensates the rest of the frame while the chip is converting,
+ *             a frame without the new data flag is dropped with 5,
+ *             call it after bme680_get_measurement_duration's time to avoid the polling
+ */
+uint8_t bme680_read_continuous(bme680_handle_t *handle, bme680_sample_t *sample);
+
+/**
+ * @brief     stop the free running mode
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 5 read timeout
+ * @note      it waits for the running conversion so the chip is in the sleep mode after this
+ */
+uint8_t bme680_stop_continuous(bme680_handle_t *handle);
+
 /**
  * @brief      read the temperature pressure and humidity data
  * @param[in]  *handle pointer to a bme680 handle structure
@@ -513,10 +761,26 @@ uint8_t bme680_read_gas_resistance(bme680_handle_t *handle, uint16_t *adc_raw, u
  *            - 1 soft reset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the chip is left in the sleep mode so a running free running mode is stopped
  */
 uint8_t bme680_soft_reset(bme680_handle_t *handle);
 
+/**
+ * @brief     reset the chip and restore its configuration
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 recover failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 configuration cache is invalid
+ * @note      the cached ctrl, config and heater registers are written back in one burst with ctrl_meas last,
+ *            the calibration is checked against its checksum and only read from the nvm again on a mismatch,
+ *            the chip is left in the sleep mode so a running free running mode is stopped,
+ *            and the sample cache is dropped
+ */
+uint8_t bme680_recover(bme680_handle_t *handle);
+
 /**
  * @brief     set humidity oversampling
  * @param[in] *handle pointer to a bme680 handle structure
@@ -552,7 +816,7 @@ uint8_t bme680_get_humidity_oversampling(bme680_handle_t *handle, bme680_oversam
  *            - 1 set temperature oversampling failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      it also updates the next trigger of a running free running mode
  */
 uint8_t bme680_set_temperature_oversampling(bme680_handle_t *handle, bme680_oversampling_t oversampling);
 
@@ -578,7 +842,7 @@ uint8_t bme680_get_temperature_oversampling(bme680_handle_t *handle, bme680_over
  *            - 1 set pressure oversampling failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      it also updates the next trigger of a running free running mode
  */
 uint8_t bme680_set_pressure_oversampling(bme680_handle_t *handle, bme680_oversampling_t oversampling);
 
@@ -604,7 +868,7 @@ uint8_t bme680_get_pressure_oversampling(bme680_handle_t *handle, bme680_oversam
  *            - 1 set mode failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the sleep mode stops a running free running mode
  */
 uint8_t bme680_set_mode(bme680_handle_t *handle, bme680_mode_t mode);
 
@@ -897,7 +1161,7 @@ uint8_t bme680_get_idac_heater(bme680_handle_t *handle, uint8_t index, uint8_t *
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 index > 9
- * @note      none
+ * @note      the register is kept as written, so the ambient temperature feedback no longer updates this index
  */
 uint8_t bme680_set_resistance_heater(bme680_handle_t *handle, uint8_t index, uint8_t reg);
 
@@ -999,6 +1263,192 @@ uint8_t bme680_idac_heater_convert_to_register(bme680_handle_t *handle, float ma
  */
 uint8_t bme680_idac_heater_convert_to_data(bme680_handle_t *handle, uint8_t reg, float *ma);
 
+/**
+ * @brief      get the expected measurement duration of one forced conversion
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *us pointer to a duration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get measurement duration failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the duration is calculated from the current oversampling, run gas, convert index and gas wait settings
+ */
+uint8_t bme680_get_measurement_duration(bme680_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief      get the temperature pressure humidity of the finished conversion
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a converted pressure buffer
+ * @param[out] *humidity_raw pointer to a raw humidity buffer
+ * @param[out] *humidity_percentage pointer to a converted humidity percentage buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 compensate failed
+ *             - 5 data is not ready
+ * @note       this function doesn't start a conversion and doesn't wait,
+ *             start the conversion with bme680_set_mode(handle, BME680_MODE_FORCED) and
+ *             call this function after bme680_get_measurement_duration's time
+ */
+uint8_t bme680_get_temperature_pressure_humidity(bme680_handle_t *handle, uint32_t *temperature_raw, float *temperature_c,
+                                                 uint32_t *pressure_raw, float *pressure_pa,
+                                                 uint32_t *humidity_raw, float *humidity_percentage);
+
+/**
+ * @brief     set the sample cache max age
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] ms max age in ms and 0 means disable
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 get_time_ms is null
+ * @note      every finished conversion saves its sample, bme680_read_temperature, bme680_read_pressure and
+ *            bme680_read_humidity return the saved values without bus traffic while the sample is younger than ms,
+ *            the oversampling, filter, mode and raw register setters drop the saved sample
+ */
+uint8_t bme680_set_cache_max_age(bme680_handle_t *handle, uint32_t ms);
+
+/**
+ * @brief      get the sample cache max age
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *ms pointer to a max age buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bme680_get_cache_max_age(bme680_handle_t *handle, uint32_t *ms);
+
+/**
+ * @brief     set the ambient temperature feedback
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] threshold drift threshold in degree c and 0 means disable
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled every compensated temperature is compared with the ambient temperature of the heater formula,
+ *            once the drift reaches threshold the ambient temperature is updated and the heater registers set by
+ *            bme680_set_heater_temperature are recomputed and rewritten,
+ *            the free running mode rewrites them before it triggers the next conversion
+ */
+uint8_t bme680_set_ambient_feedback(bme680_handle_t *handle, uint8_t threshold);
+
+/**
+ * @brief      get the ambient temperature feedback
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *threshold pointer to a drift threshold buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bme680_get_ambient_feedback(bme680_handle_t *handle, uint8_t *threshold);
+
+/**
+ * @brief     set the bus retry policy
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] times retry times of one failed transaction, 0 means disable and the max is 16
+ * @param[in] backoff_ms first backoff in ms, doubled after every retry
+ * @param[in] budget_ms max total backoff of one transaction in ms and 0 means no limit
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 times is over 16
+ * @note      only the failed register transaction is repeated, so a finished conversion is not thrown away,
+ *            the bus stays locked during the backoff
+ */
+uint8_t bme680_set_retry(bme680_handle_t *handle, uint8_t times, uint16_t backoff_ms, uint32_t budget_ms);
+
+/**
+ * @brief      get the bus retry policy
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *times pointer to a retry times buffer
+ * @param[out] *backoff_ms pointer to a first backoff buffer
+ * @param[out] *budget_ms pointer to a max total backoff buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bme680_get_retry(bme680_handle_t *handle, uint8_t *times, uint16_t *backoff_ms, uint32_t *budget_ms);
+
+/**
+ * @brief      get the bus retry statistics
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *retries pointer to a retry counter buffer
+ * @param[out] *failed pointer to a failed transaction counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the counters run since the initialization or the last bme680_clear_retry_statistics
+ */
+uint8_t bme680_get_retry_statistics(bme680_handle_t *handle, uint32_t *retries, uint32_t *failed);
+
+/**
+ * @brief     clear the bus retry statistics
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bme680_clear_retry_statistics(bme680_handle_t *handle);
+
+/**
+ * @brief     set the conversion timeout margin
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] ms timeout margin in ms and 0 means the fixed 10s timeout
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the conversion timeout is the expected measurement duration plus the margin,
+ *            so a stuck chip returns the read timeout soon after its conversion should have finished
+ */
+uint8_t bme680_set_timeout_margin(bme680_handle_t *handle, uint16_t ms);
+
+/**
+ * @brief      get the conversion timeout margin
+ * @param[in]  *handle pointer to a bme680 handle structure
+ * @param[out] *ms pointer to a timeout margin buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bme680_get_timeout_margin(bme680_handle_t *handle, uint16_t *ms);
+
+/**
+ * @brief     set the heater temperature of one index
+ * @param[in] *handle pointer to a bme680 handle structure
+ * @param[in] index input index
+ * @param[in] degree_celsius heater temperature in degree c
+ * @return    status code
+ *            - 0 success
+ *            - 1 set heater temperature failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 index > 9
+ * @note      the register is computed with the current ambient temperature and the target is kept
+ *            so the ambient temperature feedback can recompute it
+ */
+uint8_t bme680_set_heater_temperature(bme680_handle_t *handle, uint8_t index, float degree_celsius);
+
 /**
  * @}
  */
@@ -54,6 +54,7 @@ uint8_t bme680_read_test(bme680_interface_t interface, bme680_address_t addr_pin
     uint8_t res;
     uint8_t reg;
     uint32_t i;
+    uint32_t j;
     uint32_t temperature_raw;
     uint32_t pressure_raw;
     uint32_t humidity_raw;
@@ -64,6 +65,10 @@ uint8_t bme680_read_test(bme680_interface_t interface, bme680_address_t addr_pin
     uint8_t adc_range;
     float ohms;
     uint8_t index_output;
+    uint16_t count;
+    float reference_c;
+    bme680_sample_t sample;
+    bme680_sample_t samples[3];
     bme680_info_t info;
     
     /* link interface function */
@@ -78,6 +83,9 @@ uint8_t bme680_read_test(bme680_interface_t interface, bme680_address_t addr_pin
     DRIVER_BME680_LINK_SPI_WRITE(&gs_handle, bme680_interface_spi_write);
     DRIVER_BME680_LINK_DELAY_MS(&gs_handle, bme680_interface_delay_ms);
     DRIVER_BME680_LINK_DEBUG_PRINT(&gs_handle, bme680_interface_debug_print);
+    DRIVER_BME680_LINK_BUS_LOCK(&gs_handle, bme680_interface_bus_lock);
+    DRIVER_BME680_LINK_BUS_UNLOCK(&gs_handle, bme680_interface_bus_unlock);
+    DRIVER_BME680_LINK_GET_TIME_MS(&gs_handle, bme680_interface_get_time_ms);
     
     /* get bme680 info */
     res = bme680_info(&info);
@@ -309,6 +317,169 @@ uint8_t bme680_read_test(bme680_interface_t interface, bme680_address_t addr_pin
         bme680_interface_debug_print("bme680: gas resistance is %0.2fohms.\n", ohms);
     }
     
+    /* bme680_read_selective test */
+    bme680_interface_debug_print("bme680: bme680_read_selective test.\n");
+    
+    /* read the reference temperature */
+    res = bme680_read_temperature(&gs_handle, &temperature_raw, &reference_c);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: read temperature failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* read temperature and pressure only, the unused buffers keep their values */
+    humidity_raw = 0xFFFFFFFFU;
+    humidity_percentage = -1.0f;
+    ohms = -1.0f;
+    index_output = 0xFF;
+    res = bme680_read_selective(&gs_handle, BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE,
+                                &temperature_raw, &temperature_c,
+                                &pressure_raw, &pressure_pa,
+                                &humidity_raw, &humidity_percentage,
+                                &adc_raw, &adc_range, &ohms, &index_output);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: read selective failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: temperature is %0.2fC.\n", temperature_c);
+    bme680_interface_debug_print("bme680: pressure is %0.2fpa.\n", pressure_pa);
+    bme680_interface_debug_print("bme680: check selective temperature %s.\n",
+                                 ((temperature_c > reference_c - 2.0f) && (temperature_c < reference_c + 2.0f)) ? "ok" : "error");
+    bme680_interface_debug_print("bme680: check unselected outputs %s.\n",
+                                 ((humidity_raw == 0xFFFFFFFFU) && (humidity_percentage < 0.0f) &&
+                                  (ohms < 0.0f) && (index_output == 0xFF)) ? "ok" : "error");
+    
+    /* read gas only, the unselected buffers can be NULL */
+    res = bme680_read_selective(&gs_handle, BME680_OUTPUT_GAS,
+                                NULL, NULL, NULL, NULL, NULL, NULL,
+                                &adc_raw, &adc_range, &ohms, &index_output);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: read selective failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: gas index is %d.\n", index_output);
+    bme680_interface_debug_print("bme680: gas resistance is %0.2fohms.\n", ohms);
+    bme680_interface_debug_print("bme680: check selective gas %s.\n", (ohms > 0.0f) && (index_output == index) ? "ok" : "error");
+    
+    /* an empty mask is rejected */
+    res = bme680_read_selective(&gs_handle, 0,
+                                &temperature_raw, &temperature_c,
+                                &pressure_raw, &pressure_pa,
+                                &humidity_raw, &humidity_percentage,
+                                &adc_raw, &adc_range, &ohms, &index_output);
+    bme680_interface_debug_print("bme680: check invalid mask %s.\n", (res == 8) ? "ok" : "error");
+    
+    /* bme680_read_sample test */
+    bme680_interface_debug_print("bme680: bme680_read_sample test.\n");
+    
+    /* read all the outputs */
+    res = bme680_read_sample(&gs_handle, BME680_OUTPUT_ALL, &sample);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: read sample failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: temperature is %0.2fC.\n", sample.temperature_c);
+    bme680_interface_debug_print("bme680: pressure is %0.2fpa.\n", sample.pressure_pa);
+    bme680_interface_debug_print("bme680: humidity is %0.2f%%.\n", sample.humidity_percentage);
+    bme680_interface_debug_print("bme680: gas index is %d.\n", sample.index);
+    bme680_interface_debug_print("bme680: gas resistance is %0.2fohms.\n", sample.ohms);
+    bme680_interface_debug_print("bme680: check sample mask %s.\n", (sample.mask == BME680_OUTPUT_ALL) ? "ok" : "error");
+    bme680_interface_debug_print("bme680: check sample status %s.\n",
+                                 (sample.status == (BME680_SAMPLE_STATUS_GAS_VALID | BME680_SAMPLE_STATUS_HEATER_STABLE)) ? "ok" : "error");
+    bme680_interface_debug_print("bme680: check sample temperature %s.\n",
+                                 ((sample.temperature_c > reference_c - 2.0f) && (sample.temperature_c < reference_c + 2.0f)) ? "ok" : "error");
+    
+    /* read humidity only, the temperature is compensated internally but not reported */
+    res = bme680_read_sample(&gs_handle, BME680_OUTPUT_HUMIDITY, &sample);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: read sample failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: humidity is %0.2f%%.\n", sample.humidity_percentage);
+    bme680_interface_debug_print("bme680: check disabled outputs %s.\n",
+                                 ((sample.mask == BME680_OUTPUT_HUMIDITY) && (sample.status == 0)) ? "ok" : "error");
+    
+    /* bme680_read_samples test */
+    bme680_interface_debug_print("bme680: bme680_read_samples test.\n");
+    
+    res = bme680_read_samples(&gs_handle, BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY, samples, 3, &count);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: read samples failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    for (j = 0; j < 3; j++)
+    {
+        bme680_interface_debug_print("bme680: sample %d temperature is %0.2fC.\n", j, samples[j].temperature_c);
+        bme680_interface_debug_print("bme680: sample %d pressure is %0.2fpa.\n", j, samples[j].pressure_pa);
+        bme680_interface_debug_print("bme680: sample %d humidity is %0.2f%%.\n", j, samples[j].humidity_percentage);
+    }
+    bme680_interface_debug_print("bme680: check samples count %s.\n", count == 3 ? "ok" : "error");
+    bme680_interface_debug_print("bme680: check samples mask %s.\n",
+                                 ((samples[0].mask == (BME680_OUTPUT_TEMPERATURE | BME680_OUTPUT_PRESSURE | BME680_OUTPUT_HUMIDITY)) &&
+                                  (samples[1].mask == samples[0].mask) && (samples[2].mask == samples[0].mask)) ? "ok" : "error");
+    bme680_interface_debug_print("bme680: check samples order %s.\n",
+                                 ((samples[1].timestamp_ms >= samples[0].timestamp_ms) &&
+                                  (samples[2].timestamp_ms >= samples[1].timestamp_ms)) ? "ok" : "error");
+    
+    /* bme680_start_continuous/bme680_read_continuous/bme680_stop_continuous test */
+    bme680_interface_debug_print("bme680: bme680_start_continuous/bme680_read_continuous/bme680_stop_continuous test.\n");
+    
+    res = bme680_start_continuous(&gs_handle, BME680_OUTPUT_ALL);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: start continuous failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    for (j = 0; j < 3; j++)
+    {
+        res = bme680_read_continuous(&gs_handle, &samples[j]);
+        if (res != 0)
+        {
+            bme680_interface_debug_print("bme680: read continuous failed.\n");
+            (void)bme680_stop_continuous(&gs_handle);
+            (void)bme680_deinit(&gs_handle); 
+            
+            return 1;
+        }
+        bme680_interface_debug_print("bme680: frame %d temperature is %0.2fC.\n", j, samples[j].temperature_c);
+        bme680_interface_debug_print("bme680: frame %d gas resistance is %0.2fohms.\n", j, samples[j].ohms);
+    }
+    bme680_interface_debug_print("bme680: check continuous mask %s.\n",
+                                 ((samples[0].mask == BME680_OUTPUT_ALL) && (samples[1].mask == BME680_OUTPUT_ALL) &&
+                                  (samples[2].mask == BME680_OUTPUT_ALL)) ? "ok" : "error");
+    bme680_interface_debug_print("bme680: check continuous temperature %s.\n",
+                                 ((samples[2].temperature_c > reference_c - 2.0f) && (samples[2].temperature_c < reference_c + 2.0f)) ? "ok" : "error");
+    res = bme680_stop_continuous(&gs_handle);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: stop continuous failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    res = bme680_read_continuous(&gs_handle, &sample);
+    bme680_interface_debug_print("bme680: check continuous stop %s.\n", (res == 9) ? "ok" : "error");
+    
     /* finish read test */
     bme680_interface_debug_print("bme680: finish read test.\n");
     (void)bme680_set_heater_off(&gs_handle, BME680_BOOL_TRUE);
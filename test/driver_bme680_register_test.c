@@ -57,9 +57,24 @@ uint8_t bme680_register_test(bme680_interface_t interface, bme680_address_t addr
     uint8_t index;
     uint8_t index_check;
     uint16_t ms;
+    uint16_t ms_check;
     float degree_celsius;
     float ma;
     float ma_check;
+    uint32_t age;
+    uint32_t age_check;
+    uint8_t threshold;
+    uint8_t threshold_check;
+    uint8_t times;
+    uint8_t times_check;
+    uint16_t backoff_ms;
+    uint16_t backoff_ms_check;
+    uint32_t budget_ms;
+    uint32_t budget_ms_check;
+    uint32_t retry_count;
+    uint32_t retry_failed;
+    uint8_t burst[3];
+    uint8_t burst_check[2];
     bme680_info_t info;
     bme680_address_t addr_pin_check;
     bme680_interface_t interface_check;
@@ -81,6 +96,9 @@ uint8_t bme680_register_test(bme680_interface_t interface, bme680_address_t addr
     DRIVER_BME680_LINK_SPI_WRITE(&gs_handle, bme680_interface_spi_write);
     DRIVER_BME680_LINK_DELAY_MS(&gs_handle, bme680_interface_delay_ms);
     DRIVER_BME680_LINK_DEBUG_PRINT(&gs_handle, bme680_interface_debug_print);
+    DRIVER_BME680_LINK_BUS_LOCK(&gs_handle, bme680_interface_bus_lock);
+    DRIVER_BME680_LINK_BUS_UNLOCK(&gs_handle, bme680_interface_bus_unlock);
+    DRIVER_BME680_LINK_GET_TIME_MS(&gs_handle, bme680_interface_get_time_ms);
     
     /* get bme680 info */
     res = bme680_info(&info);
@@ -1337,6 +1355,242 @@ uint8_t bme680_register_test(bme680_interface_t interface, bme680_address_t addr
     }
     bme680_interface_debug_print("bme680: idac heater ma after is %0.2fmA.\n", ma_check);
     
+    /* bme680_set_cache_max_age/bme680_get_cache_max_age test */
+    bme680_interface_debug_print("bme680: bme680_set_cache_max_age/bme680_get_cache_max_age test.\n");
+    
+    age = rand() % 1000 + 1;
+    res = bme680_set_cache_max_age(&gs_handle, age);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set cache max age failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: set cache max age %dms.\n", age);
+    res = bme680_get_cache_max_age(&gs_handle, &age_check);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get cache max age failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: check cache max age %s.\n", age == age_check ? "ok" : "error");
+    res = bme680_set_cache_max_age(&gs_handle, 0);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set cache max age failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* bme680_set_ambient_feedback/bme680_get_ambient_feedback test */
+    bme680_interface_debug_print("bme680: bme680_set_ambient_feedback/bme680_get_ambient_feedback test.\n");
+    
+    threshold = rand() % 10 + 1;
+    res = bme680_set_ambient_feedback(&gs_handle, threshold);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set ambient feedback failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: set ambient feedback %dC.\n", threshold);
+    res = bme680_get_ambient_feedback(&gs_handle, &threshold_check);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get ambient feedback failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: check ambient feedback %s.\n", threshold == threshold_check ? "ok" : "error");
+    res = bme680_set_ambient_feedback(&gs_handle, 0);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set ambient feedback failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* bme680_set_retry/bme680_get_retry test */
+    bme680_interface_debug_print("bme680: bme680_set_retry/bme680_get_retry test.\n");
+    
+    times = rand() % 16 + 1;
+    backoff_ms = rand() % 10;
+    budget_ms = rand() % 1000;
+    res = bme680_set_retry(&gs_handle, times, backoff_ms, budget_ms);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set retry failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: set retry %d times, backoff %dms, budget %dms.\n", times, backoff_ms, budget_ms);
+    res = bme680_get_retry(&gs_handle, &times_check, &backoff_ms_check, &budget_ms_check);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get retry failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: check retry %s.\n",
+                                 ((times == times_check) && (backoff_ms == backoff_ms_check) && (budget_ms == budget_ms_check)) ? "ok" : "error");
+    res = bme680_set_retry(&gs_handle, 0, 0, 0);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set retry failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* bme680_get_retry_statistics/bme680_clear_retry_statistics test */
+    bme680_interface_debug_print("bme680: bme680_get_retry_statistics/bme680_clear_retry_statistics test.\n");
+    
+    res = bme680_clear_retry_statistics(&gs_handle);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: clear retry statistics failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    res = bme680_get_retry_statistics(&gs_handle, &retry_count, &retry_failed);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get retry statistics failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: check retry statistics %s.\n", ((retry_count == 0) && (retry_failed == 0)) ? "ok" : "error");
+    
+    /* bme680_set_timeout_margin/bme680_get_timeout_margin test */
+    bme680_interface_debug_print("bme680: bme680_set_timeout_margin/bme680_get_timeout_margin test.\n");
+    
+    ms = rand() % 100 + 1;
+    res = bme680_set_timeout_margin(&gs_handle, ms);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set timeout margin failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: set timeout margin %dms.\n", ms);
+    res = bme680_get_timeout_margin(&gs_handle, &ms_check);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get timeout margin failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: check timeout margin %s.\n", ms == ms_check ? "ok" : "error");
+    res = bme680_set_timeout_margin(&gs_handle, 0);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set timeout margin failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* bme680_set_heater_temperature test */
+    bme680_interface_debug_print("bme680: bme680_set_heater_temperature test.\n");
+    
+    degree_celsius = (float)(rand() % 200) + 200.0f;
+    res = bme680_set_heater_temperature(&gs_handle, 0, degree_celsius);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set heater temperature failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: set heater temperature %0.1fC.\n", degree_celsius);
+    res = bme680_resistance_heater_convert_to_register(&gs_handle, degree_celsius, &reg);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: resistance heater convert to register failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    res = bme680_get_resistance_heater(&gs_handle, 0, &reg_check);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get resistance heater failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: check heater temperature %s.\n", reg == reg_check ? "ok" : "error");
+    
+    /* bme680_recover test */
+    bme680_interface_debug_print("bme680: bme680_recover test.\n");
+    
+    /* set filter coeff 7 */
+    res = bme680_set_filter(&gs_handle, BME680_FILTER_COEFF_7);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set filter failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* set index 0 and 1 gas wait in one register pair burst */
+    burst[0] = rand() % 0xFFU;
+    burst[1] = 0x65;
+    burst[2] = rand() % 0xFFU;
+    res = bme680_set_reg(&gs_handle, 0x64, burst, 3);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: set reg failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: set filter coeff 7 and index 0 1 gas wait 0x%02X 0x%02X in one burst.\n", burst[0], burst[2]);
+    
+    /* recover */
+    res = bme680_recover(&gs_handle);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: recover failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    
+    /* get filter */
+    res = bme680_get_filter(&gs_handle, &filter);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get filter failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    res = bme680_get_reg(&gs_handle, 0x64, burst_check, 2);
+    if (res != 0)
+    {
+        bme680_interface_debug_print("bme680: get reg failed.\n");
+        (void)bme680_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bme680_interface_debug_print("bme680: check recover %s.\n",
+                                 ((filter == BME680_FILTER_COEFF_7) && (burst[0] == burst_check[0]) && (burst[2] == burst_check[1])) ? "ok" : "error");
+    
     /* bme680_soft_reset test */
     bme680_interface_debug_print("bme680: bme680_soft_reset test.\n");
     